@@ -0,0 +1,224 @@
+// binder.cpp
+#include "../include/binder.h"
+
+Binder::Binder() : inFunctionBody(false), nextSlot(0), frameSize(0), expressionCount(0) {}
+
+void Binder::bind(const std::vector<std::unique_ptr<Statement>>& statements) {
+    // First pass: register all function declarations for forward references
+    for (const auto& stmt : statements) {
+        if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt.get())) {
+            // Duplicate definitions are left unbound
+            std::vector<TypeRef> parameters;
+            for (const auto& param : funcDecl->getParameters()) {
+                parameters.push_back(types.declared(param.type, param.isPointer));
+            }
+            TypeRef signature = types.function(types.declared(funcDecl->getReturnType(), false), parameters);
+            funcDecl->setBinding(declareFunction(funcDecl->getName(), signature));
+        }
+    }
+
+    // Second pass: bind all statements
+    for (const auto& stmt : statements) {
+        bindStatement(stmt.get());
+    }
+}
+
+void Binder::bindExpression(const Expression* expr) {
+    if (!expr) {
+        return;
+    }
+    expr->setId(expressionCount++);
+
+    if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
+        identifierExpr->setBinding(resolve(identifierExpr->getName()));
+    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        bindExpression(unaryExpr->getOperand());
+    } else if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        bindExpression(binaryExpr->getLeft());
+        bindExpression(binaryExpr->getRight());
+    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        // The operands only decide where to branch
+        bindCondition(logicalExpr->getLeft());
+        bindCondition(logicalExpr->getRight());
+        std::string_view name = logicalExpr->getOperator() == TokenType::AND ? "&&" : "||";
+        logicalExpr->setBinding(declareTemporary(name, primitiveType(TypeId::BOOL)));
+    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
+        bindExpression(assignExpr->getValue());
+        assignExpr->setBinding(resolve(assignExpr->getName()));
+    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
+        for (const auto& arg : callExpr->getArguments()) {
+            bindExpression(arg.get());
+        }
+        callExpr->setBinding(resolve(callExpr->getCallee()));
+    }
+}
+
+void Binder::bindCondition(const Expression* expr) {
+    // Conditions are lowered to branches through &&, || and !
+    auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr);
+    auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr);
+    if (logicalExpr) {
+        expr->setId(expressionCount++);
+        bindCondition(logicalExpr->getLeft());
+        bindCondition(logicalExpr->getRight());
+    } else if (unaryExpr && unaryExpr->getOperator() == TokenType::NOT) {
+        expr->setId(expressionCount++);
+        bindCondition(unaryExpr->getOperand());
+    } else {
+        bindExpression(expr);
+    }
+}
+
+void Binder::bindStatement(const Statement* stmt) {
+    if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
+        bindExpression(exprStmt->getExpression());
+    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
+        bindBlock(blockStmt);
+    } else if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
+        bindVariableDeclaration(varDecl);
+    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
+        bindFunctionDeclaration(funcDecl);
+    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
+        bindCondition(ifStmt->getCondition());
+        bindStatement(ifStmt->getThenBranch());
+        if (ifStmt->getElseBranch()) {
+            bindStatement(ifStmt->getElseBranch());
+        }
+    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
+        bindCondition(whileStmt->getCondition());
+        bindStatement(whileStmt->getBody());
+    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
+        bindForStatement(forStmt);
+    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
+        bindExpression(returnStmt->getValue());
+    }
+}
+
+void Binder::bindBlock(const BlockStatement* stmt) {
+    enterScope();
+
+    for (const auto& statement : stmt->getStatements()) {
+        bindStatement(statement.get());
+    }
+
+    exitScope();
+}
+
+void Binder::bindVariableDeclaration(const VariableDeclaration* stmt) {
+    // The initializer cannot see the variable it initializes
+    bindExpression(stmt->getInitializer());
+
+    // Names may not shadow anything visible, matching the type checker's rules
+    if (symbolTable.resolve(stmt->getName()) >= 0) {
+        return;
+    }
+
+    stmt->setBinding(declareVariable(stmt->getName(), types.declared(stmt->getType(), stmt->getIsPointer()),
+                                     Symbol::SymbolKind::VARIABLE));
+}
+
+void Binder::bindFunctionDeclaration(const FunctionDeclaration* stmt) {
+    bool previousInFunction = inFunctionBody;
+    inFunctionBody = true;
+    nextSlot = 0;
+    frameSize = 0;
+    int firstExpression = expressionCount;
+
+    // Enter function scope; parameters take the first slots
+    enterScope();
+
+    for (const auto& param : stmt->getParameters()) {
+        param.binding = declareVariable(param.name, types.declared(param.type, param.isPointer),
+                                        Symbol::SymbolKind::PARAMETER);
+    }
+
+    // A hidden variable for passes that need to keep the return value
+    if (stmt->getReturnType() != TokenType::VOID) {
+        stmt->setResultBinding(declareTemporary("return", types.declared(stmt->getReturnType(), false)));
+    }
+
+    bindStatement(stmt->getBody());
+
+    exitScope();
+
+    stmt->setFrameSize(frameSize);
+    stmt->setExpressionRange(firstExpression, expressionCount - firstExpression);
+    inFunctionBody = previousInFunction;
+}
+
+void Binder::bindForStatement(const ForStatement* stmt) {
+    enterScope();
+
+    if (stmt->getInitializer()) {
+        bindStatement(stmt->getInitializer());
+    }
+    bindCondition(stmt->getCondition());
+    bindExpression(stmt->getIncrement());
+    bindStatement(stmt->getBody());
+
+    exitScope();
+}
+
+void Binder::enterScope() {
+    symbolTable.enterScope();
+    slotMarks.push_back(nextSlot);
+}
+
+void Binder::exitScope() {
+    symbolTable.exitScope();
+    nextSlot = slotMarks.back();
+    slotMarks.pop_back();
+}
+
+Binding Binder::declareVariable(std::string_view name, TypeRef type, Symbol::SymbolKind kind) {
+    // Globals live outside any frame
+    int slot = inFunctionBody ? nextSlot : -1;
+
+    Binding binding;
+    binding.symbol = symbolTable.emplace(name, type, kind, slot);
+    if (binding.isResolved() && slot >= 0) {
+        binding.slot = slot;
+        if (++nextSlot > frameSize) {
+            frameSize = nextSlot;
+        }
+    }
+    return binding;
+}
+
+Binding Binder::declareTemporary(std::string_view name, TypeRef type) {
+    // Lives in the frame like a local, or with the globals at top level
+    int slot = inFunctionBody ? nextSlot : -1;
+
+    Binding binding;
+    binding.symbol = symbolTable.addHidden(Symbol(name, type, Symbol::SymbolKind::VARIABLE, slot));
+    if (slot >= 0) {
+        binding.slot = slot;
+        if (++nextSlot > frameSize) {
+            frameSize = nextSlot;
+        }
+    }
+    return binding;
+}
+
+Binding Binder::declareFunction(std::string_view name, TypeRef signature) {
+    Binding binding;
+    binding.symbol = symbolTable.emplace(name, signature, Symbol::SymbolKind::FUNCTION);
+    return binding;
+}
+
+Binding Binder::resolveGlobal(std::string_view name) const {
+    // Once binding is done only the global scope is open
+    Binding binding;
+    binding.symbol = symbolTable.resolve(name);
+    return binding;
+}
+
+Binding Binder::resolve(const std::string& name) {
+    Binding binding;
+    int index = symbolTable.resolve(name);
+    if (index >= 0) {
+        binding.symbol = index;
+        binding.slot = symbolTable.get(index).slot;
+    }
+    return binding;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+// binder.h
+#pragma once
+#include "ast.h"
+#include "symboltable.h"
+#include <string>
+#include <memory>
+#include <vector>
+
+// Name resolution pass. Walks the AST once with a scoped SymbolTable and
+// records on every use site (identifiers, assignments, calls) and declaration
+// the index of the Symbol it refers to plus its frame slot. Later phases read
+// these bindings instead of looking names up again.
+//
+// Unresolved uses and redefinitions are left unbound; the TypeChecker reports them.
+// Every expression also gets a dense id for side tables such as expression types.
+class Binder {
+private:
+    SymbolTable symbolTable;
+    TypeTable types;
+
+    // Frame slot allocation for the function being bound. Slots are reused
+    // once the scope that declared them is closed.
+    bool inFunctionBody;
+    int nextSlot;
+    int frameSize;
+    std::vector<int> slotMarks;
+
+    // Expressions are numbered in the order they are bound
+    int expressionCount;
+
+    // Binding methods for expressions; logical operators used as values get
+    // a hidden variable, those only branched on do not
+    void bindExpression(const Expression* expr);
+    void bindCondition(const Expression* expr);
+
+    // Binding methods for statements
+    void bindStatement(const Statement* stmt);
+    void bindBlock(const BlockStatement* stmt);
+    void bindVariableDeclaration(const VariableDeclaration* stmt);
+    void bindFunctionDeclaration(const FunctionDeclaration* stmt);
+    void bindForStatement(const ForStatement* stmt);
+
+    // Utility methods
+    void enterScope();
+    void exitScope();
+    Binding declareVariable(std::string_view name, TypeRef type, Symbol::SymbolKind kind);
+    Binding declareFunction(std::string_view name, TypeRef signature);
+    Binding declareTemporary(std::string_view name, TypeRef type);
+    Binding resolve(const std::string& name);
+
+public:
+    Binder();
+    void bind(const std::vector<std::unique_ptr<Statement>>& statements);
+
+    const std::vector<Symbol>& getSymbols() const { return symbolTable.getSymbols(); }
+    const Symbol& getSymbol(const Binding& binding) const { return symbolTable.get(binding.symbol); }
+    const TypeTable& getTypes() const { return types; }
+    Binding resolveGlobal(std::string_view name) const;
+    int getExpressionCount() const { return expressionCount; }
+};
\ No newline at end of file
@@ -0,0 +1,46 @@
+// bitset.cpp
+#include "../include/bitset.h"
+
+void BitSet::clear() {
+    for (uint64_t& word : words) {
+        word = 0;
+    }
+}
+
+uint32_t BitSet::count() const {
+    uint32_t total = 0;
+    for (uint64_t word : words) {
+        total += static_cast<uint32_t>(__builtin_popcountll(word));
+    }
+    return total;
+}
+
+bool BitSet::unionWith(const BitSet& other) {
+    uint64_t changed = 0;
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t merged = words[w] | other.words[w];
+        changed |= merged ^ words[w];
+        words[w] = merged;
+    }
+    return changed != 0;
+}
+
+bool BitSet::intersectWith(const BitSet& other) {
+    uint64_t changed = 0;
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t common = words[w] & other.words[w];
+        changed |= common ^ words[w];
+        words[w] = common;
+    }
+    return changed != 0;
+}
+
+bool BitSet::subtract(const BitSet& other) {
+    uint64_t changed = 0;
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t rest = words[w] & ~other.words[w];
+        changed |= rest ^ words[w];
+        words[w] = rest;
+    }
+    return changed != 0;
+}
\ No newline at end of file
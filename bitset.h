@@ -0,0 +1,45 @@
+// bitset.h
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// A fixed-size set of small integers stored as 64-bit words. Set operations
+// run a word at a time in plain loops the compiler can vectorize.
+class BitSet {
+private:
+    std::vector<uint64_t> words;
+    uint32_t bitCount = 0;
+
+public:
+    BitSet() = default;
+    explicit BitSet(uint32_t size) : words((size + 63) / 64, 0), bitCount(size) {}
+    
+    uint32_t size() const { return bitCount; }
+    bool test(uint32_t bit) const { return (words[bit / 64] >> (bit % 64)) & 1; }
+    void set(uint32_t bit) { words[bit / 64] |= uint64_t(1) << (bit % 64); }
+    void reset(uint32_t bit) { words[bit / 64] &= ~(uint64_t(1) << (bit % 64)); }
+    void clear();
+    uint32_t count() const;
+    
+    // Each returns whether the set changed
+    bool unionWith(const BitSet& other);
+    bool intersectWith(const BitSet& other);
+    bool subtract(const BitSet& other);
+    
+    bool operator==(const BitSet& other) const { return words == other.words; }
+    bool operator!=(const BitSet& other) const { return words != other.words; }
+    
+    // Calls visit with each member in increasing order
+    template <typename Visit>
+    void forEach(Visit&& visit) const;
+};
+
+template <typename Visit>
+void BitSet::forEach(Visit&& visit) const {
+    for (size_t w = 0; w < words.size(); ++w) {
+        for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+            visit(static_cast<uint32_t>(w * 64 + __builtin_ctzll(word)));
+        }
+    }
+}
\ No newline at end of file
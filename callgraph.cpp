@@ -0,0 +1,92 @@
+// callgraph.cpp
+#include "../include/callgraph.h"
+#include <algorithm>
+
+CallGraph::CallGraph(const IRProgram& program) : callees(program.functions.size()) {
+    for (uint32_t f = 0; f < program.functions.size(); ++f) {
+        if (program.functions[f].symbol >= 0) {
+            functionIndex.emplace(static_cast<uint32_t>(program.functions[f].symbol), f);
+        }
+    }
+    for (uint32_t f = 0; f < program.functions.size(); ++f) {
+        for (const Instruction& instr : program.functions[f].instructions) {
+            int callee = instr.opcode == OpCode::CALL ? functionOf(instr.getArg1().id) : -1;
+            if (callee >= 0 && std::find(callees[f].begin(), callees[f].end(), callee) == callees[f].end()) {
+                callees[f].push_back(static_cast<uint32_t>(callee));
+            }
+        }
+    }
+    computeComponents();
+}
+
+int CallGraph::functionOf(uint32_t symbol) const {
+    auto it = functionIndex.find(symbol);
+    return it == functionIndex.end() ? -1 : static_cast<int>(it->second);
+}
+
+void CallGraph::computeComponents() {
+    // Tarjan's algorithm, iterative since call chains can be deep. Each stack
+    // entry is a function and the index of the next callee to visit.
+    // Components are completed callees first, which is the bottom-up order.
+    constexpr uint32_t NONE = UINT32_MAX;
+    std::vector<uint32_t> index(callees.size(), NONE);
+    std::vector<uint32_t> lowLink(callees.size(), 0);
+    std::vector<bool> onStack(callees.size(), false);
+    std::vector<uint32_t> open;
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    components.assign(callees.size(), NONE);
+    recursive.assign(callees.size(), false);
+    uint32_t counter = 0;
+    uint32_t componentCount = 0;
+    
+    for (uint32_t root = 0; root < callees.size(); ++root) {
+        if (index[root] != NONE) {
+            continue;
+        }
+        stack.emplace_back(root, 0);
+        index[root] = lowLink[root] = counter++;
+        open.push_back(root);
+        onStack[root] = true;
+        while (!stack.empty()) {
+            auto& [function, next] = stack.back();
+            if (next < callees[function].size()) {
+                uint32_t callee = callees[function][next++];
+                if (callee == function) {
+                    recursive[function] = true;
+                } else if (index[callee] == NONE) {
+                    index[callee] = lowLink[callee] = counter++;
+                    open.push_back(callee);
+                    onStack[callee] = true;
+                    stack.emplace_back(callee, 0);
+                } else if (onStack[callee]) {
+                    lowLink[function] = std::min(lowLink[function], index[callee]);
+                }
+                continue;
+            }
+            
+            uint32_t finished = function;
+            stack.pop_back();
+            if (!stack.empty()) {
+                uint32_t caller = stack.back().first;
+                lowLink[caller] = std::min(lowLink[caller], lowLink[finished]);
+            }
+            if (lowLink[finished] != index[finished]) {
+                continue;
+            }
+            
+            // The finished function is the root of a component
+            size_t first = open.size();
+            do {
+                --first;
+            } while (open[first] != finished);
+            for (size_t i = first; i < open.size(); ++i) {
+                components[open[i]] = componentCount;
+                onStack[open[i]] = false;
+                recursive[open[i]] = recursive[open[i]] || open.size() - first > 1;
+                bottomUpOrder.push_back(open[i]);
+            }
+            open.resize(first);
+            ++componentCount;
+        }
+    }
+}
\ No newline at end of file
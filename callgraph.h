@@ -0,0 +1,34 @@
+// callgraph.h
+#pragma once
+#include "ir.h"
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+// Calls between the functions of an IRProgram, and its strongly connected
+// components. Functions are named by their index in IRProgram::functions.
+// Calls to functions without a body have no edge.
+class CallGraph {
+private:
+    std::unordered_map<uint32_t, uint32_t> functionIndex;   // Function symbol to index
+    std::vector<std::vector<uint32_t>> callees;             // Distinct callees of each function
+    std::vector<uint32_t> components;                       // Component of each function
+    std::vector<bool> recursive;
+    std::vector<uint32_t> bottomUpOrder;
+    
+    void computeComponents();
+
+public:
+    explicit CallGraph(const IRProgram& program);
+    
+    size_t size() const { return callees.size(); }
+    // Index of the function with the given symbol, -1 if it has no body
+    int functionOf(uint32_t symbol) const;
+    const std::vector<uint32_t>& getCallees(uint32_t function) const { return callees[function]; }
+    uint32_t getComponent(uint32_t function) const { return components[function]; }
+    // Whether the function can call itself, directly or through others
+    bool isRecursive(uint32_t function) const { return recursive[function]; }
+    // Every function after the functions it calls, except for calls within
+    // a component
+    const std::vector<uint32_t>& getBottomUpOrder() const { return bottomUpOrder; }
+};
\ No newline at end of file
@@ -0,0 +1,363 @@
+// cfg.cpp
+#include "../include/cfg.h"
+#include <algorithm>
+
+ControlFlowGraph::ControlFlowGraph(const IRFunction& function) {
+    buildBlocks(function);
+    buildEdges(function);
+    computeReversePostorder();
+    computeDominators();
+}
+
+void ControlFlowGraph::buildBlocks(const IRFunction& function) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    labelBlocks.assign(function.labelCount + 1, NONE);
+    
+    // A block starts at the first instruction, at every label and after every
+    // branch or return
+    uint32_t start = 0;
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        if (instr.opcode == OpCode::LABEL && i > start) {
+            blocks.push_back({start, i, 0, {}, {}});
+            start = i;
+        }
+        if (instr.opcode == OpCode::LABEL) {
+            labelBlocks[instr.getArg1().id] = static_cast<uint32_t>(blocks.size());
+        }
+        if (isBranch(instr.opcode) || instr.opcode == OpCode::RET) {
+            blocks.push_back({start, i + 1, 0, {}, {}});
+            start = i + 1;
+        }
+    }
+    if (start < instructions.size()) {
+        blocks.push_back({start, static_cast<uint32_t>(instructions.size()), 0, {}, {}});
+    }
+    
+    for (auto& block : blocks) {
+        if (instructions[block.first].opcode == OpCode::LABEL) {
+            block.label = instructions[block.first].getArg1().id;
+        }
+    }
+}
+
+void ControlFlowGraph::buildEdges(const IRFunction& function) {
+    auto addEdge = [this](uint32_t from, uint32_t to) {
+        // Both ways of a conditional branch may lead to the same block
+        if (std::find(blocks[from].successors.begin(), blocks[from].successors.end(), to) == blocks[from].successors.end()) {
+            blocks[from].successors.push_back(to);
+            blocks[to].predecessors.push_back(from);
+        }
+    };
+    
+    for (uint32_t b = 0; b < blocks.size(); ++b) {
+        const Instruction& last = function.instructions[blocks[b].last - 1];
+        bool fallsThrough = b + 1 < blocks.size();
+        switch (last.opcode) {
+            case OpCode::JMP:
+                addEdge(b, labelBlocks[last.getArg1().id]);
+                fallsThrough = false;
+                break;
+            case OpCode::JZ:
+            case OpCode::JNZ:
+                if (fallsThrough) {
+                    addEdge(b, b + 1);
+                }
+                addEdge(b, labelBlocks[last.getArg2().id]);
+                fallsThrough = false;
+                break;
+            case OpCode::RET:
+                fallsThrough = false;
+                break;
+            default:
+                break;
+        }
+        if (fallsThrough) {
+            addEdge(b, b + 1);
+        }
+    }
+}
+
+void ControlFlowGraph::computeReversePostorder() {
+    orderIndex.assign(blocks.size(), NONE);
+    if (blocks.empty()) {
+        return;
+    }
+    
+    // Iterative depth-first search; each stack entry is a block and the index
+    // of the next successor to visit
+    std::vector<uint32_t> postorder;
+    std::vector<bool> visited(blocks.size(), false);
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    stack.emplace_back(0, 0);
+    visited[0] = true;
+    while (!stack.empty()) {
+        auto& [block, next] = stack.back();
+        if (next < blocks[block].successors.size()) {
+            uint32_t successor = blocks[block].successors[next++];
+            if (!visited[successor]) {
+                visited[successor] = true;
+                stack.emplace_back(successor, 0);
+            }
+        } else {
+            postorder.push_back(block);
+            stack.pop_back();
+        }
+    }
+    
+    reversePostorder.assign(postorder.rbegin(), postorder.rend());
+    for (uint32_t i = 0; i < reversePostorder.size(); ++i) {
+        orderIndex[reversePostorder[i]] = i;
+    }
+}
+
+uint32_t ControlFlowGraph::intersect(uint32_t a, uint32_t b) const {
+    // Walk up from the later block in reverse postorder until the paths meet
+    while (a != b) {
+        while (orderIndex[a] > orderIndex[b]) {
+            a = immediateDominators[a];
+        }
+        while (orderIndex[b] > orderIndex[a]) {
+            b = immediateDominators[b];
+        }
+    }
+    return a;
+}
+
+void ControlFlowGraph::computeDominators() {
+    // Cooper, Harvey and Kennedy's iterative algorithm over reverse postorder
+    immediateDominators.assign(blocks.size(), NONE);
+    dominatorChildren.assign(blocks.size(), {});
+    if (blocks.empty()) {
+        return;
+    }
+    
+    immediateDominators[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 1; i < reversePostorder.size(); ++i) {
+            uint32_t block = reversePostorder[i];
+            uint32_t dominator = NONE;
+            for (uint32_t predecessor : blocks[block].predecessors) {
+                if (immediateDominators[predecessor] == NONE) {
+                    continue;
+                }
+                dominator = dominator == NONE ? predecessor : intersect(predecessor, dominator);
+            }
+            if (dominator != immediateDominators[block]) {
+                immediateDominators[block] = dominator;
+                changed = true;
+            }
+        }
+    }
+    
+    for (size_t i = 1; i < reversePostorder.size(); ++i) {
+        uint32_t block = reversePostorder[i];
+        dominatorChildren[immediateDominators[block]].push_back(block);
+    }
+}
+
+bool ControlFlowGraph::dominates(uint32_t a, uint32_t b) const {
+    if (!isReachable(a) || !isReachable(b)) {
+        return false;
+    }
+    
+    // Dominators of b come no later than b in reverse postorder
+    while (orderIndex[b] > orderIndex[a]) {
+        b = immediateDominators[b];
+    }
+    return a == b;
+}
+
+std::vector<std::vector<uint32_t>> ControlFlowGraph::computeDominanceFrontiers() const {
+    // A join point is in the frontier of every block from each predecessor up
+    // to, but excluding, the join point's immediate dominator
+    std::vector<std::vector<uint32_t>> frontiers(blocks.size());
+    for (uint32_t block : reversePostorder) {
+        if (blocks[block].predecessors.size() < 2) {
+            continue;
+        }
+        for (uint32_t predecessor : blocks[block].predecessors) {
+            if (!isReachable(predecessor)) {
+                continue;
+            }
+            uint32_t runner = predecessor;
+            while (runner != immediateDominators[block]) {
+                std::vector<uint32_t>& frontier = frontiers[runner];
+                if (frontier.empty() || frontier.back() != block) {
+                    frontier.push_back(block);
+                }
+                if (runner == 0) {
+                    break;
+                }
+                runner = immediateDominators[runner];
+            }
+        }
+    }
+    return frontiers;
+}
+
+std::vector<NaturalLoop> ControlFlowGraph::findNaturalLoops() const {
+    std::vector<NaturalLoop> loops;
+    std::vector<uint32_t> visited(blocks.size(), NONE);
+    for (uint32_t header : reversePostorder) {
+        // The loop of a back edge is the header plus every block that reaches
+        // the edge's source without passing through the header
+        NaturalLoop loop{header, {header}, {}};
+        for (uint32_t predecessor : blocks[header].predecessors) {
+            if (isReachable(predecessor) && dominates(header, predecessor)) {
+                loop.latches.push_back(predecessor);
+            }
+        }
+        if (loop.latches.empty()) {
+            continue;
+        }
+        visited[header] = header;
+        std::vector<uint32_t> worklist(loop.latches);
+        while (!worklist.empty()) {
+            uint32_t block = worklist.back();
+            worklist.pop_back();
+            if (visited[block] == header) {
+                continue;
+            }
+            visited[block] = header;
+            loop.blocks.push_back(block);
+            for (uint32_t predecessor : blocks[block].predecessors) {
+                if (isReachable(predecessor)) {
+                    worklist.push_back(predecessor);
+                }
+            }
+        }
+        
+        std::sort(loop.blocks.begin(), loop.blocks.end(), [&](uint32_t a, uint32_t b) {
+            return orderIndex[a] < orderIndex[b];
+        });
+        loops.push_back(std::move(loop));
+    }
+    
+    // A loop nested in another has fewer blocks
+    std::stable_sort(loops.begin(), loops.end(), [](const NaturalLoop& a, const NaturalLoop& b) {
+        return a.blocks.size() < b.blocks.size();
+    });
+    return loops;
+}
+
+std::vector<uint32_t> ControlFlowGraph::computeLoopDepths() const {
+    std::vector<uint32_t> depths(blocks.size(), 0);
+    for (const NaturalLoop& loop : findNaturalLoops()) {
+        for (uint32_t block : loop.blocks) {
+            ++depths[block];
+        }
+    }
+    return depths;
+}
+
+uint32_t ControlFlowGraph::getPreheader(const NaturalLoop& loop) const {
+    uint32_t preheader = NONE;
+    for (uint32_t predecessor : blocks[loop.header].predecessors) {
+        bool isLatch = std::find(loop.latches.begin(), loop.latches.end(), predecessor) != loop.latches.end();
+        if (!isReachable(predecessor) || isLatch) {
+            continue;
+        }
+        if (preheader != NONE || blocks[predecessor].successors.size() != 1) {
+            return NONE;
+        }
+        preheader = predecessor;
+    }
+    return preheader;
+}
+
+bool insertPreheader(IRFunction& function, const ControlFlowGraph& cfg, const NaturalLoop& loop) {
+    std::vector<Instruction>& instructions = function.instructions;
+    const BasicBlock& header = cfg.getBlock(loop.header);
+    std::vector<bool> inLoop(cfg.size(), false);
+    for (uint32_t block : loop.blocks) {
+        inLoop[block] = true;
+    }
+    std::vector<uint32_t> entering;
+    for (uint32_t predecessor : header.predecessors) {
+        if (cfg.isReachable(predecessor) && !inLoop[predecessor]) {
+            if (cfg.getBlock(predecessor).label == 0) {
+                return false;
+            }
+            entering.push_back(predecessor);
+        }
+    }
+    if (entering.empty() || header.label == 0) {
+        return false;
+    }
+    
+    // A loop block that would fall through into the preheader jumps to the
+    // header instead
+    std::vector<Instruction> preheader;
+    Operand label = function.newLabel();
+    for (uint32_t predecessor : header.predecessors) {
+        if (inLoop[predecessor] && cfg.getBlock(predecessor).last == header.first &&
+            instructions[header.first - 1].opcode != OpCode::JMP && instructions[header.first - 1].opcode != OpCode::RET) {
+            preheader.emplace_back(OpCode::JMP, TypeId::VOID, Operand(), Operand(OperandKind::LABEL, header.label));
+        }
+    }
+    preheader.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), label);
+    
+    // PHI arguments of entering edges move to the preheader, merged by a PHI
+    // of its own if there is more than one
+    for (uint32_t i = header.first; i < header.last; ++i) {
+        Instruction& phi = instructions[i];
+        if (phi.opcode != OpCode::PHI) {
+            continue;
+        }
+        std::vector<PhiArgument> inside;
+        std::vector<PhiArgument> outside;
+        for (uint32_t a = phi.getArg1().id; a < phi.getArg1().id + phi.getArg2().id; ++a) {
+            const PhiArgument& argument = function.phiArguments[a];
+            uint32_t block = cfg.blockOfLabel(argument.label);
+            if (block < cfg.size() && cfg.isReachable(block)) {
+                (inLoop[block] ? inside : outside).push_back(argument);
+            }
+        }
+        Operand value = outside.empty() ? Operand() : outside[0].value;
+        if (outside.size() > 1) {
+            value = function.newTemp();
+            uint32_t first = static_cast<uint32_t>(function.phiArguments.size());
+            function.phiArguments.insert(function.phiArguments.end(), outside.begin(), outside.end());
+            preheader.emplace_back(OpCode::PHI, phi.type, value, immediateOperand(first),
+                                   immediateOperand(static_cast<uint32_t>(outside.size())));
+        }
+        if (!value.isNone()) {
+            inside.push_back({label.id, value});
+        }
+        uint32_t first = static_cast<uint32_t>(function.phiArguments.size());
+        function.phiArguments.insert(function.phiArguments.end(), inside.begin(), inside.end());
+        phi.setOperand(Instruction::ARG1, immediateOperand(first));
+        phi.setOperand(Instruction::ARG2, immediateOperand(static_cast<uint32_t>(inside.size())));
+    }
+    
+    for (uint32_t predecessor : entering) {
+        Instruction& branch = instructions[cfg.getBlock(predecessor).last - 1];
+        int target = branch.opcode == OpCode::JMP ? Instruction::ARG1 : Instruction::ARG2;
+        if (isBranch(branch.opcode) && branch.getOperand(target).id == header.label) {
+            branch.setOperand(target, label);
+        }
+    }
+    instructions.insert(instructions.begin() + header.first, preheader.begin(), preheader.end());
+    return true;
+}
+
+bool removeUnreachableBlocks(IRFunction& function) {
+    ControlFlowGraph cfg(function);
+    if (cfg.getReversePostorder().size() == cfg.size()) {
+        return false;
+    }
+    
+    std::vector<bool> removed(function.instructions.size(), false);
+    for (uint32_t b = 0; b < cfg.size(); ++b) {
+        if (!cfg.isReachable(b)) {
+            const BasicBlock& block = cfg.getBlock(b);
+            std::fill(removed.begin() + block.first, removed.begin() + block.last, true);
+        }
+    }
+    
+    removeInstructions(function, removed);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+// cfg.h
+#pragma once
+#include "ir.h"
+#include <vector>
+#include <cstdint>
+
+// A maximal run of instructions entered only at the top and left only at
+// the bottom. Blocks refer to a contiguous range of their function's
+// instructions; a LABEL, if any, is the first instruction of its block.
+struct BasicBlock {
+    uint32_t first;                      // First instruction
+    uint32_t last;                       // One past the last instruction
+    uint32_t label;                      // Label starting the block, 0 if none
+    std::vector<uint32_t> predecessors;
+    std::vector<uint32_t> successors;
+};
+
+// Blocks of the loop closed by the back edges into one header, which
+// dominates all of them. Loops with the same header are merged.
+struct NaturalLoop {
+    uint32_t header;
+    std::vector<uint32_t> blocks;        // Header first, then in reverse postorder
+    std::vector<uint32_t> latches;       // Sources of the back edges
+};
+
+// Control-flow graph of one IRFunction, with its reverse postorder and
+// dominator tree. Block 0 is the entry. Blocks that cannot be reached from
+// the entry are kept but have no position in the order and no dominator.
+// The graph indexes into the function, so it must be rebuilt after the
+// instruction list changes.
+class ControlFlowGraph {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
+    std::vector<BasicBlock> blocks;
+    std::vector<uint32_t> labelBlocks;       // Block starting with each label
+    std::vector<uint32_t> reversePostorder;
+    std::vector<uint32_t> orderIndex;        // Position of each block in reversePostorder
+    std::vector<uint32_t> immediateDominators;
+    std::vector<std::vector<uint32_t>> dominatorChildren;
+    
+    void buildBlocks(const IRFunction& function);
+    void buildEdges(const IRFunction& function);
+    void computeReversePostorder();
+    void computeDominators();
+    uint32_t intersect(uint32_t a, uint32_t b) const;
+
+public:
+    explicit ControlFlowGraph(const IRFunction& function);
+    
+    size_t size() const { return blocks.size(); }
+    const BasicBlock& getBlock(uint32_t block) const { return blocks[block]; }
+    const std::vector<BasicBlock>& getBlocks() const { return blocks; }
+    uint32_t blockOfLabel(uint32_t label) const { return labelBlocks[label]; }
+    
+    const std::vector<uint32_t>& getReversePostorder() const { return reversePostorder; }
+    bool isReachable(uint32_t block) const { return orderIndex[block] != NONE; }
+    
+    // Dominator tree; the entry and unreachable blocks have no immediate dominator
+    bool hasImmediateDominator(uint32_t block) const { return immediateDominators[block] != NONE && block != 0; }
+    uint32_t getImmediateDominator(uint32_t block) const { return immediateDominators[block]; }
+    const std::vector<uint32_t>& getDominatorChildren(uint32_t block) const { return dominatorChildren[block]; }
+    bool dominates(uint32_t a, uint32_t b) const;
+    std::vector<std::vector<uint32_t>> computeDominanceFrontiers() const;
+    // Natural loops found from the back edges, inner loops before the loops
+    // around them; loops that are not reducible are missed
+    std::vector<NaturalLoop> findNaturalLoops() const;
+    // Number of natural loops around each block
+    std::vector<uint32_t> computeLoopDepths() const;
+    // The one block entering a loop's header, if it has no other successor;
+    // UINT32_MAX otherwise
+    uint32_t getPreheader(const NaturalLoop& loop) const;
+};
+
+// Gives a loop a preheader right before its header that takes over the
+// edges entering the loop, with the PHI arguments they carry. Returns false
+// without changes if a block entering the loop has no label to name it by.
+bool insertPreheader(IRFunction& function, const ControlFlowGraph& cfg, const NaturalLoop& loop);
+
+// Removes the blocks that cannot be reached from the entry; returns whether
+// there were any
+bool removeUnreachableBlocks(IRFunction& function);
\ No newline at end of file
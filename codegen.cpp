@@ -1,333 +1,575 @@
-#include "../include/codegen.h"
-#include <iostream>
-#include <sstream>
-
-CodeGenerator::CodeGenerator()
-    : tempVarCounter(0), labelCounter(0) {}
-
-std::string CodeGenerator::generateTemp() {
-    return "t" + std::to_string(++tempVarCounter);
-}
-
-std::string CodeGenerator::generateLabel() {
-    return "L" + std::to_string(++labelCounter);
-}
-
-void CodeGenerator::generateExpression(const Expression* expr) {
-    if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
-        generateBinaryExpression(binaryExpr);
-    } else if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
-        generateIdentifier(identifierExpr);
-    } else if (auto* literalExpr = dynamic_cast<const LiteralExpression*>(expr)) {
-        generateLiteral(literalExpr);
-    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
-        generateFunctionCall(callExpr);
-    } else {
-        // Handle other expression types
-        std::cerr << "Warning: Unsupported expression type" << std::endl;
-    }
-}
-
-void CodeGenerator::generateStatement(const Statement* stmt) {
-    if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
-        generateVariableDeclaration(varDecl);
-    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
-        generateFunctionDeclaration(funcDecl);
-    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
-        generateBlock(blockStmt);
-    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
-        generateIfStatement(ifStmt);
-    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
-        generateWhileStatement(whileStmt);
-    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
-        generateForStatement(forStmt);
-    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
-        generateReturnStatement(returnStmt);
-    } else if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
-        generateExpression(exprStmt->getExpression());
-    } else {
-        std::cerr << "Warning: Unsupported statement type" << std::endl;
-    }
-}
-
-void CodeGenerator::generate(const std::vector<std::unique_ptr<Statement>>& statements) {
-    for (const auto& stmt : statements) {
-        generateStatement(stmt.get());
-    }
-}
-
-const std::vector<Instruction>& CodeGenerator::getInstructions() const {
-    return instructions;
-}
-
-void CodeGenerator::optimize() {
-    // Basic optimization: remove redundant loads/stores
-    auto it = instructions.begin();
-    while (it != instructions.end()) {
-        if (it->opcode == OpCode::LOAD && std::next(it) != instructions.end() &&
-            std::next(it)->opcode == OpCode::STORE) {
-            it = instructions.erase(it);
-            it = instructions.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-void CodeGenerator::dumpCode() const {
-    for (const auto& instr : instructions) {
-        std::cout << "  ";
-        switch (instr.opcode) {
-            case OpCode::LOAD:
-                std::cout << "LOAD " << instr.arg1 << " -> " << instr.result;
-                break;
-            case OpCode::STORE:
-                std::cout << "STORE " << instr.arg1 << " -> " << instr.result;
-                break;
-            case OpCode::ADD:
-                std::cout << "ADD " << instr.arg1 << ", " << instr.arg2 << " -> " << instr.result;
-                break;
-            case OpCode::SUB:
-                std::cout << "SUB " << instr.arg1 << ", " << instr.arg2 << " -> " << instr.result;
-                break;
-            case OpCode::MUL:
-                std::cout << "MUL " << instr.arg1 << ", " << instr.arg2 << " -> " << instr.result;
-                break;
-            case OpCode::DIV:
-                std::cout << "DIV " << instr.arg1 << ", " << instr.arg2 << " -> " << instr.result;
-                break;
-            case OpCode::CMP:
-                std::cout << "CMP " << instr.arg1 << ", " << instr.arg2 << " -> " << instr.result;
-                break;
-            case OpCode::JMP:
-                std::cout << "JMP " << instr.arg1;
-                break;
-            case OpCode::JE:
-                std::cout << "JE " << instr.arg1;
-                break;
-            case OpCode::JNE:
-                std::cout << "JNE " << instr.arg1;
-                break;
-            case OpCode::JG:
-                std::cout << "JG " << instr.arg1;
-                break;
-            case OpCode::JL:
-                std::cout << "JL " << instr.arg1;
-                break;
-            case OpCode::CALL:
-                std::cout << "CALL " << instr.arg1;
-                break;
-            case OpCode::RET:
-                std::cout << "RET";
-                break;
-            case OpCode::PUSH:
-                std::cout << "PUSH " << instr.arg1;
-                break;
-            case OpCode::POP:
-                std::cout << "POP";
-                break;
-            case OpCode::PRINT:
-                std::cout << "PRINT " << instr.arg1;
-                break;
-            case OpCode::LABEL:
-                std::cout << instr.arg1 << ":";
-                break;
-            default:
-                std::cout << "Unknown instruction";
-        }
-        std::cout << std::endl;
-    }
-}
-
-void CodeGenerator::generateVariableDeclaration(const VariableDeclaration* decl) {
-    // Generate code for initializer if present
-    std::string value;
-    if (const Expression* init = decl->getInitializer()) {
-        generateExpression(init);
-        value = generateTemp();
-    }
-    
-    // Store the value in the variable
-    instructions.emplace_back(OpCode::STORE, value, "", decl->getName());
-}
-
-void CodeGenerator::generateFunctionDeclaration(const FunctionDeclaration* decl) {
-    // Generate function label
-    std::string label = decl->getName();
-    instructions.emplace_back(OpCode::LABEL, label, "", "");
-    
-    // Generate code for function body
-    if (const Statement* body = decl->getBody()) {
-        generateStatement(body);
-    }
-    
-    // Add return instruction if not present
-    if (instructions.empty() || instructions.back().opcode != OpCode::RET) {
-        instructions.emplace_back(OpCode::RET, "", "", "");
-    }
-}
-
-void CodeGenerator::generateBlock(const BlockStatement* block) {
-    // Generate code for each statement in the block
-    for (const auto& stmt : block->getStatements()) {
-        generateStatement(stmt.get());
-    }
-}
-
-void CodeGenerator::generateIfStatement(const IfStatement* ifStmt) {
-    std::string elseLabel = generateLabel();
-    std::string endLabel = generateLabel();
-    
-    // Generate condition code
-    generateExpression(ifStmt->getCondition());
-    instructions.emplace_back(OpCode::JE, elseLabel);
-    
-    // Generate then branch
-    generateStatement(ifStmt->getThenBranch());
-    instructions.emplace_back(OpCode::JMP, endLabel);
-    
-    // Generate else branch if present
-    instructions.emplace_back(OpCode::LABEL, elseLabel);
-    if (const Statement* elseBranch = ifStmt->getElseBranch()) {
-        generateStatement(elseBranch);
-    }
-    
-    instructions.emplace_back(OpCode::LABEL, endLabel);
-}
-
-void CodeGenerator::generateWhileStatement(const WhileStatement* whileStmt) {
-    std::string startLabel = generateLabel();
-    std::string endLabel = generateLabel();
-    
-    // Generate loop header
-    instructions.emplace_back(OpCode::LABEL, startLabel);
-    
-    // Generate condition code
-    generateExpression(whileStmt->getCondition());
-    instructions.emplace_back(OpCode::JE, endLabel);
-    
-    // Generate loop body
-    generateStatement(whileStmt->getBody());
-    instructions.emplace_back(OpCode::JMP, startLabel);
-    
-    // Generate loop end
-    instructions.emplace_back(OpCode::LABEL, endLabel);
-}
-
-void CodeGenerator::generateForStatement(const ForStatement* forStmt) {
-    std::string startLabel = generateLabel();
-    std::string endLabel = generateLabel();
-    
-    // Generate initializer
-    if (const Statement* init = forStmt->getInitializer()) {
-        generateStatement(init);
-    }
-    
-    // Generate loop header
-    instructions.emplace_back(OpCode::LABEL, startLabel);
-    
-    // Generate condition code
-    if (const Expression* cond = forStmt->getCondition()) {
-        generateExpression(cond);
-        instructions.emplace_back(OpCode::JE, endLabel);
-    }
-    
-    // Generate loop body
-    generateStatement(forStmt->getBody());
-    
-    // Generate increment
-    if (const Expression* inc = forStmt->getIncrement()) {
-        generateExpression(inc);
-    }
-    
-    instructions.emplace_back(OpCode::JMP, startLabel);
-    instructions.emplace_back(OpCode::LABEL, endLabel);
-}
-
-void CodeGenerator::generateReturnStatement(const ReturnStatement* returnStmt) {
-    // Generate code for return value if present
-    if (const Expression* value = returnStmt->getValue()) {
-        generateExpression(value);
-    }
-    
-    instructions.emplace_back(OpCode::RET);
-}
-
-void CodeGenerator::generateBinaryExpression(const BinaryExpression* expr) {
-    // Generate code for operands
-    generateExpression(expr->getLeft());
-    std::string leftTemp = generateTemp();
-    
-    generateExpression(expr->getRight());
-    std::string rightTemp = generateTemp();
-    
-    // Generate operation
-    std::string resultTemp = generateTemp();
-    switch (expr->getOperator()) {
-        case TokenType::PLUS:
-            instructions.emplace_back(OpCode::ADD, leftTemp, rightTemp, resultTemp);
-            break;
-        case TokenType::MINUS:
-            instructions.emplace_back(OpCode::SUB, leftTemp, rightTemp, resultTemp);
-            break;
-        case TokenType::MULTIPLY:
-            instructions.emplace_back(OpCode::MUL, leftTemp, rightTemp, resultTemp);
-            break;
-        case TokenType::SLASH:
-            instructions.emplace_back(OpCode::DIV, leftTemp, rightTemp, resultTemp);
-            break;
-        case TokenType::EQUAL_EQUAL:
-        case TokenType::NOT_EQUAL:
-        case TokenType::LESS:
-        case TokenType::LESS_EQUAL:
-        case TokenType::GREATER:
-        case TokenType::GREATER_EQUAL:
-            instructions.emplace_back(OpCode::CMP, leftTemp, rightTemp, resultTemp);
-            break;
-        default:
-            std::cerr << "Warning: Unsupported binary operator" << std::endl;
-            break;
-    }
-}
-
-void CodeGenerator::generateIdentifier(const IdentifierExpression* expr) {
-    std::string temp = generateTemp();
-    instructions.emplace_back(OpCode::LOAD, expr->getName(), "", temp);
-}
-
-void CodeGenerator::generateLiteral(const LiteralExpression* expr) {
-    std::string temp = generateTemp();
-    instructions.emplace_back(OpCode::STORE, expr->getValue(), "", temp);
-}
-
-void CodeGenerator::generateFunctionCall(const CallExpression* expr) {
-    std::vector<std::string> argTemps;
-    
-    // Generate code for arguments
-    for (const auto& arg : expr->getArguments()) {
-        generateExpression(arg.get());
-        std::string temp = generateTemp();
-        argTemps.push_back(temp);
-    }
-    
-    // Push arguments
-    for (const auto& temp : argTemps) {
-        instructions.emplace_back(OpCode::PUSH, temp, "", "");
-    }
-    
-    // Generate call
-    instructions.emplace_back(OpCode::CALL, expr->getCallee(), "", "");
-    
-    // Pop arguments
-    for (size_t i = 0; i < argTemps.size(); ++i) {
-        instructions.emplace_back(OpCode::POP, "", "", "");
-    }
-    
-    // Store return value
-    std::string resultTemp = generateTemp();
-    instructions.emplace_back(OpCode::STORE, "retval", "", resultTemp);
-}
-
-std::string CodeGenerator::getOutput() const {
-    return output.str();
-} 
\ No newline at end of file
+#include "../include/codegen.h"
+#include <iostream>
+#include <sstream>
+
+CodeGenerator::CodeGenerator(const Binder& binder, const TypeChecker& typeChecker, const ConstantFolder& folder)
+    : binder(binder), typeChecker(typeChecker), folder(folder), current(0) {}
+
+void CodeGenerator::emit(OpCode op, TypeId type, Operand result, Operand arg1, Operand arg2) {
+    function().instructions.emplace_back(op, type, result, arg1, arg2);
+}
+
+Operand CodeGenerator::constant(const Constant& value) {
+    return constantOperand(program.constants.intern(value));
+}
+
+TypeId CodeGenerator::typeOf(const Expression* expr) const {
+    // Type of the value as used, after any implicit conversion
+    return binder.getTypes().kindOf(typeChecker.getExpressionType(expr).converted);
+}
+
+Operand CodeGenerator::convert(const Expression* expr, Operand value) {
+    const TypeTable& types = binder.getTypes();
+    const ExpressionType& type = typeChecker.getExpressionType(expr);
+    Conversion conversion = conversionOf(types.kindOf(type.type), types.kindOf(type.converted));
+    
+    // Folded constants are emitted already converted
+    if (conversion == Conversion::NONE || folder.getConstant(expr).isConstant()) {
+        return value;
+    }
+    
+    Operand result = function().newTemp();
+    OpCode op = conversion == Conversion::INT_TO_FLOAT ? OpCode::ITOF : OpCode::FTOI;
+    emit(op, types.kindOf(type.converted), result, value);
+    return result;
+}
+
+Operand CodeGenerator::generateExpression(const Expression* expr) {
+    // Constant and simplified expressions were folded before code generation
+    const FoldedExpression& folded = folder.getFolded(expr);
+    if (folded.value.isConstant()) {
+        return generateConstant(expr);
+    }
+    if (folded.replacement) {
+        return generateExpression(folded.replacement);
+    }
+    
+    if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        return generateBinaryExpression(binaryExpr);
+    } else if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
+        return generateIdentifier(identifierExpr);
+    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
+        return generateFunctionCall(callExpr);
+    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
+        return generateAssignment(assignExpr);
+    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        return generateUnaryExpression(unaryExpr);
+    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        return generateLogicalExpression(logicalExpr);
+    }
+    
+    // Handle other expression types
+    std::cerr << "Warning: Unsupported expression type" << std::endl;
+    return Operand();
+}
+
+void CodeGenerator::generateStatement(const Statement* stmt) {
+    if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
+        generateVariableDeclaration(varDecl);
+    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
+        generateFunctionDeclaration(funcDecl);
+    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
+        generateBlock(blockStmt);
+    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
+        generateIfStatement(ifStmt);
+    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
+        generateWhileStatement(whileStmt);
+    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
+        generateForStatement(forStmt);
+    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
+        generateReturnStatement(returnStmt);
+    } else if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
+        generateExpression(exprStmt->getExpression());
+    } else {
+        std::cerr << "Warning: Unsupported statement type" << std::endl;
+    }
+}
+
+void CodeGenerator::generate(const std::vector<std::unique_ptr<Statement>>& statements) {
+    // Top-level code goes to the first function
+    program.functions.emplace_back();
+    current = 0;
+    
+    for (const auto& stmt : statements) {
+        generateStatement(stmt.get());
+    }
+    
+    // Initialization code returns like a function body
+    emit(OpCode::RET, TypeId::VOID);
+}
+
+static const char* typeSuffix(TypeId type) {
+    switch (type) {
+        case TypeId::INT: return ".i";
+        case TypeId::FLOAT: return ".f";
+        case TypeId::BOOL: return ".b";
+        case TypeId::CHAR: return ".c";
+        case TypeId::STRING: return ".s";
+        case TypeId::POINTER: return ".p";
+        default: return "";
+    }
+}
+
+std::string CodeGenerator::operandName(Operand operand) const {
+    switch (operand.kind) {
+        case OperandKind::TEMP:
+            return "t" + std::to_string(operand.id);
+        case OperandKind::LABEL:
+            return "L" + std::to_string(operand.id);
+        case OperandKind::VARIABLE:
+        case OperandKind::FUNCTION:
+            return std::string(binder.getSymbols()[operand.id].name);
+        case OperandKind::IMMEDIATE:
+            return std::to_string(operand.id);
+        case OperandKind::CONSTANT: {
+            const Constant& value = program.constants.get(operand.id);
+            if (value.type == TypeId::STRING) {
+                return "\"" + value.toString() + "\"";
+            } else if (value.type == TypeId::CHAR) {
+                return "'" + value.toString() + "'";
+            }
+            return value.toString();
+        }
+        default:
+            return "";
+    }
+}
+
+void CodeGenerator::dumpCode() const {
+    for (const auto& func : program.functions) {
+        // Top-level code has no header
+        if (func.symbol >= 0) {
+            std::cout << binder.getSymbols()[func.symbol].name << ":" << std::endl;
+        }
+        
+        // Allocated locations, as registers r0.. and spill slots s0..
+        if (func.locations.size() > 1) {
+            std::cout << "    ;";
+            for (uint32_t temp = 1; temp < func.locations.size(); ++temp) {
+                const Location& location = func.locations[temp];
+                if (location.kind != LocationKind::NONE) {
+                    std::cout << " t" << temp << "=" << (location.kind == LocationKind::REGISTER ? "r" : "s")
+                              << location.index;
+                }
+            }
+            std::cout << std::endl;
+        }
+        
+        for (const auto& instr : func.instructions) {
+            Operand result = instr.getResult();
+            Operand arg1 = instr.getArg1();
+            Operand arg2 = instr.getArg2();
+            if (instr.opcode == OpCode::LABEL) {
+                std::cout << "  " << operandName(arg1) << ":" << std::endl;
+                continue;
+            }
+            if (instr.opcode == OpCode::PHI) {
+                std::cout << "    PHI" << typeSuffix(instr.type);
+                for (uint32_t i = arg1.id; i < arg1.id + arg2.id; ++i) {
+                    const PhiArgument& incoming = func.phiArguments[i];
+                    std::cout << (i == arg1.id ? " [" : ", [") << "L" << incoming.label << ": "
+                              << operandName(incoming.value) << "]";
+                }
+                std::cout << " -> " << operandName(result) << std::endl;
+                continue;
+            }
+            
+            std::cout << "    " << opcodeName(instr.opcode) << typeSuffix(instr.type);
+            if (!arg1.isNone()) {
+                std::cout << " " << operandName(arg1);
+            }
+            if (!arg2.isNone()) {
+                std::cout << ", " << operandName(arg2);
+            }
+            if (!result.isNone()) {
+                std::cout << " -> " << operandName(result);
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+void CodeGenerator::generateVariableDeclaration(const VariableDeclaration* decl) {
+    const Binding& binding = decl->getBinding();
+    TypeId type = binder.getTypes().kindOf(binder.getSymbol(binding).type);
+    if (binding.slot >= 0) {
+        function().locals.push_back({static_cast<uint32_t>(binding.symbol), type});
+    }
+    
+    // Variables without an initializer need no code
+    const Expression* init = decl->getInitializer();
+    if (!init) {
+        return;
+    }
+    
+    // Store the initial value in the variable
+    Operand value = convert(init, generateExpression(init));
+    emit(OpCode::STORE, type, variableOperand(binding.symbol), value);
+}
+
+void CodeGenerator::generateFunctionDeclaration(const FunctionDeclaration* decl) {
+    // Each function gets its own instruction list, temps and labels
+    size_t enclosing = current;
+    current = program.functions.size();
+    program.functions.emplace_back();
+    function().symbol = decl->getBinding().symbol;
+    for (const auto& param : decl->getParameters()) {
+        TypeId type = binder.getTypes().kindOf(binder.getSymbol(param.binding).type);
+        function().parameters.push_back({static_cast<uint32_t>(param.binding.symbol), type});
+    }
+    const Binding& result = decl->getResultBinding();
+    if (result.isResolved()) {
+        function().returnValue = {static_cast<uint32_t>(result.symbol),
+                                  binder.getTypes().kindOf(binder.getSymbol(result).type)};
+    }
+    
+    // Generate code for function body
+    if (const Statement* body = decl->getBody()) {
+        generateStatement(body);
+    }
+    
+    // Add return instruction if not present
+    if (function().instructions.empty() || function().instructions.back().opcode != OpCode::RET) {
+        emit(OpCode::RET, TypeId::VOID);
+    }
+    
+    current = enclosing;
+}
+
+void CodeGenerator::generateBlock(const BlockStatement* block) {
+    // Generate code for each statement in the block
+    for (const auto& stmt : block->getStatements()) {
+        generateStatement(stmt.get());
+    }
+}
+
+void CodeGenerator::generateIfStatement(const IfStatement* ifStmt) {
+    // Only the branch taken by a constant condition is generated
+    const Constant& condition = folder.getConstant(ifStmt->getCondition());
+    if (condition.isConstant()) {
+        if (condition.isTrue()) {
+            generateStatement(ifStmt->getThenBranch());
+        } else if (const Statement* elseBranch = ifStmt->getElseBranch()) {
+            generateStatement(elseBranch);
+        }
+        return;
+    }
+    
+    Operand elseLabel = function().newLabel();
+    
+    // Generate condition code
+    generateCondition(ifStmt->getCondition(), elseLabel, false);
+    
+    // Generate then branch
+    generateStatement(ifStmt->getThenBranch());
+    
+    // Generate else branch if present
+    if (const Statement* elseBranch = ifStmt->getElseBranch()) {
+        Operand endLabel = function().newLabel();
+        emit(OpCode::JMP, TypeId::VOID, Operand(), endLabel);
+        emit(OpCode::LABEL, TypeId::VOID, Operand(), elseLabel);
+        generateStatement(elseBranch);
+        emit(OpCode::LABEL, TypeId::VOID, Operand(), endLabel);
+    } else {
+        emit(OpCode::LABEL, TypeId::VOID, Operand(), elseLabel);
+    }
+}
+
+void CodeGenerator::generateWhileStatement(const WhileStatement* whileStmt) {
+    // A loop whose condition is constant false never runs
+    const Constant& condition = folder.getConstant(whileStmt->getCondition());
+    if (condition.isConstant() && !condition.isTrue()) {
+        return;
+    }
+    
+    Operand startLabel = function().newLabel();
+    Operand endLabel = function().newLabel();
+    
+    // Generate loop header
+    emit(OpCode::LABEL, TypeId::VOID, Operand(), startLabel);
+    
+    // Generate condition code; a constant true condition needs no test
+    if (!condition.isConstant()) {
+        generateCondition(whileStmt->getCondition(), endLabel, false);
+    }
+    
+    // Generate loop body
+    generateStatement(whileStmt->getBody());
+    emit(OpCode::JMP, TypeId::VOID, Operand(), startLabel);
+    
+    // Generate loop end
+    emit(OpCode::LABEL, TypeId::VOID, Operand(), endLabel);
+}
+
+void CodeGenerator::generateForStatement(const ForStatement* forStmt) {
+    // Generate initializer
+    if (const Statement* init = forStmt->getInitializer()) {
+        generateStatement(init);
+    }
+    
+    // A loop whose condition is constant false only runs its initializer;
+    // a missing or constant true condition needs no test
+    const Expression* cond = forStmt->getCondition();
+    bool isConstant = !cond || folder.getConstant(cond).isConstant();
+    if (cond && isConstant && !folder.getConstant(cond).isTrue()) {
+        return;
+    }
+    
+    Operand startLabel = function().newLabel();
+    Operand endLabel = function().newLabel();
+    
+    // Generate loop header
+    emit(OpCode::LABEL, TypeId::VOID, Operand(), startLabel);
+    
+    // Generate condition code
+    if (!isConstant) {
+        generateCondition(cond, endLabel, false);
+    }
+    
+    // Generate loop body
+    generateStatement(forStmt->getBody());
+    
+    // Generate increment
+    if (const Expression* inc = forStmt->getIncrement()) {
+        generateExpression(inc);
+    }
+    
+    emit(OpCode::JMP, TypeId::VOID, Operand(), startLabel);
+    emit(OpCode::LABEL, TypeId::VOID, Operand(), endLabel);
+}
+
+void CodeGenerator::generateReturnStatement(const ReturnStatement* returnStmt) {
+    // Generate code for return value if present
+    if (const Expression* value = returnStmt->getValue()) {
+        Operand result = convert(value, generateExpression(value));
+        emit(OpCode::RET, typeOf(value), Operand(), result);
+    } else {
+        emit(OpCode::RET, TypeId::VOID);
+    }
+}
+
+static OpCode binaryOpCode(TokenType op) {
+    switch (op) {
+        case TokenType::PLUS: return OpCode::ADD;
+        case TokenType::MINUS: return OpCode::SUB;
+        case TokenType::MULTIPLY: return OpCode::MUL;
+        case TokenType::SLASH: return OpCode::DIV;
+        case TokenType::EQUAL_EQUAL: return OpCode::CMPEQ;
+        case TokenType::NOT_EQUAL: return OpCode::CMPNE;
+        case TokenType::LESS: return OpCode::CMPLT;
+        case TokenType::LESS_EQUAL: return OpCode::CMPLE;
+        case TokenType::GREATER: return OpCode::CMPGT;
+        default: return OpCode::CMPGE;
+    }
+}
+
+Operand CodeGenerator::generateBinaryExpression(const BinaryExpression* expr) {
+    switch (expr->getOperator()) {
+        case TokenType::PLUS:
+        case TokenType::MINUS:
+        case TokenType::MULTIPLY:
+        case TokenType::SLASH:
+        case TokenType::EQUAL_EQUAL:
+        case TokenType::NOT_EQUAL:
+        case TokenType::LESS:
+        case TokenType::LESS_EQUAL:
+        case TokenType::GREATER:
+        case TokenType::GREATER_EQUAL:
+            break;
+        default:
+            std::cerr << "Warning: Unsupported binary operator" << std::endl;
+            return Operand();
+    }
+    
+    // Generate code for operands
+    Operand left = convert(expr->getLeft(), generateExpression(expr->getLeft()));
+    Operand right = convert(expr->getRight(), generateExpression(expr->getRight()));
+    
+    // Generate operation on the promoted operand type
+    Operand result = function().newTemp();
+    emit(binaryOpCode(expr->getOperator()), typeOf(expr->getLeft()), result, left, right);
+    return result;
+}
+
+Operand CodeGenerator::generateUnaryExpression(const UnaryExpression* expr) {
+    const Expression* operand = expr->getOperand();
+    TokenType op = expr->getOperator();
+    
+    switch (op) {
+        case TokenType::PLUS:
+            return convert(operand, generateExpression(operand));
+        
+        case TokenType::MINUS:
+        case TokenType::NOT: {
+            // Negation subtracts from zero of the operand's type, and not
+            // compares with it. Floats subtract from -0.0, which gives -0.0
+            // for 0.0 where 0.0 would give 0.0.
+            Constant zero;
+            zero.type = typeOf(operand);
+            if (op == TokenType::MINUS && zero.type == TypeId::FLOAT) {
+                zero.real = -0.0f;
+            }
+            Operand value = convert(operand, generateExpression(operand));
+            Operand result = function().newTemp();
+            if (op == TokenType::MINUS) {
+                emit(OpCode::SUB, zero.type, result, constant(zero), value);
+            } else {
+                emit(OpCode::CMPEQ, zero.type, result, value, constant(zero));
+            }
+            return result;
+        }
+        
+        case TokenType::INCREMENT:
+        case TokenType::DECREMENT:
+            break;
+        
+        default:
+            std::cerr << "Warning: Unsupported unary operator" << std::endl;
+            return Operand();
+    }
+    
+    // Increment and decrement update the variable; the prefix forms yield
+    // the new value and the postfix forms the old one
+    auto* identifier = dynamic_cast<const IdentifierExpression*>(operand);
+    if (!identifier) {
+        std::cerr << "Warning: Unsupported increment target" << std::endl;
+        return Operand();
+    }
+    const Binding& binding = identifier->getBinding();
+    Constant one;
+    one.type = binder.getTypes().kindOf(binder.getSymbol(binding).type);
+    one.integer = 1;
+    one.real = 1.0f;
+    Operand old = function().newTemp();
+    Operand result = function().newTemp();
+    emit(OpCode::LOAD, one.type, old, variableOperand(binding.symbol));
+    emit(op == TokenType::INCREMENT ? OpCode::ADD : OpCode::SUB, one.type, result, old, constant(one));
+    emit(OpCode::STORE, one.type, variableOperand(binding.symbol), result);
+    return expr->isPostfix() ? old : result;
+}
+
+Operand CodeGenerator::generateLogicalExpression(const LogicalExpression* expr) {
+    // The value is stored to the hidden variable the binder declared: the
+    // result of a short circuit first, then the other result if the
+    // operands fall through
+    const Binding& binding = expr->getBinding();
+    bool isAnd = expr->getOperator() == TokenType::AND;
+    if (binding.slot >= 0) {
+        function().locals.push_back({static_cast<uint32_t>(binding.symbol), TypeId::BOOL});
+    }
+    Constant shortCircuit;
+    shortCircuit.type = TypeId::BOOL;
+    shortCircuit.integer = isAnd ? 0 : 1;
+    Constant fallThrough = shortCircuit;
+    fallThrough.integer = !shortCircuit.integer;
+    
+    Operand endLabel = function().newLabel();
+    emit(OpCode::STORE, TypeId::BOOL, variableOperand(binding.symbol), constant(shortCircuit));
+    generateCondition(expr->getLeft(), endLabel, !isAnd);
+    generateCondition(expr->getRight(), endLabel, !isAnd);
+    emit(OpCode::STORE, TypeId::BOOL, variableOperand(binding.symbol), constant(fallThrough));
+    emit(OpCode::LABEL, TypeId::VOID, Operand(), endLabel);
+    
+    Operand result = function().newTemp();
+    emit(OpCode::LOAD, TypeId::BOOL, result, variableOperand(binding.symbol));
+    return result;
+}
+
+void CodeGenerator::generateCondition(const Expression* expr, Operand target, bool jumpIfTrue) {
+    // Folded conditions jump unconditionally or not at all
+    const FoldedExpression& folded = folder.getFolded(expr);
+    if (folded.value.isConstant()) {
+        if (folded.value.isTrue() == jumpIfTrue) {
+            emit(OpCode::JMP, TypeId::VOID, Operand(), target);
+        }
+        return;
+    }
+    if (folded.replacement) {
+        generateCondition(folded.replacement, target, jumpIfTrue);
+        return;
+    }
+    
+    // a && b is false as soon as a is, and a || b true as soon as a is;
+    // otherwise b decides
+    if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        bool isAnd = logicalExpr->getOperator() == TokenType::AND;
+        if (isAnd != jumpIfTrue) {
+            generateCondition(logicalExpr->getLeft(), target, jumpIfTrue);
+            generateCondition(logicalExpr->getRight(), target, jumpIfTrue);
+        } else {
+            Operand decided = function().newLabel();
+            generateCondition(logicalExpr->getLeft(), decided, !jumpIfTrue);
+            generateCondition(logicalExpr->getRight(), target, jumpIfTrue);
+            emit(OpCode::LABEL, TypeId::VOID, Operand(), decided);
+        }
+        return;
+    }
+    auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr);
+    if (unaryExpr && unaryExpr->getOperator() == TokenType::NOT) {
+        generateCondition(unaryExpr->getOperand(), target, !jumpIfTrue);
+        return;
+    }
+    
+    // Anything else, a comparison included, is branched on directly
+    Operand value = convert(expr, generateExpression(expr));
+    emit(jumpIfTrue ? OpCode::JNZ : OpCode::JZ, typeOf(expr), Operand(), value, target);
+}
+
+Operand CodeGenerator::generateConstant(const Expression* expr) {
+    // The folded value, converted to the type it is used as. A float out of
+    // the range of int is left to convert at runtime, where it traps.
+    const Constant& folded = folder.getConstant(expr);
+    TypeId type = typeOf(expr);
+    Constant value = convertConstant(folded, type);
+    if (!value.isConstant()) {
+        Operand result = function().newTemp();
+        emit(OpCode::FTOI, type, result, constant(folded));
+        return result;
+    }
+    value.type = type;
+    
+    return constant(value);
+}
+
+Operand CodeGenerator::generateIdentifier(const IdentifierExpression* expr) {
+    Operand temp = function().newTemp();
+    emit(OpCode::LOAD, binder.getTypes().kindOf(typeChecker.getExpressionType(expr).type),
+         temp, variableOperand(expr->getBinding().symbol));
+    return temp;
+}
+
+Operand CodeGenerator::generateAssignment(const AssignExpression* expr) {
+    // Generate code for the assigned value
+    Operand value = convert(expr->getValue(), generateExpression(expr->getValue()));
+    
+    // Store the value in the bound variable; it is also the value of the assignment
+    const Binding& binding = expr->getBinding();
+    emit(OpCode::STORE, binder.getTypes().kindOf(binder.getSymbol(binding).type),
+         variableOperand(binding.symbol), value);
+    return value;
+}
+
+Operand CodeGenerator::generateFunctionCall(const CallExpression* expr) {
+    std::vector<Operand> arguments;
+    
+    // Generate code for arguments
+    for (const auto& arg : expr->getArguments()) {
+        arguments.push_back(convert(arg.get(), generateExpression(arg.get())));
+    }
+    
+    // Push arguments
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        emit(OpCode::PUSH, typeOf(expr->getArguments()[i].get()), Operand(), arguments[i]);
+    }
+    
+    // Generate call; the callee pops its arguments and void calls have no result
+    TypeId type = binder.getTypes().kindOf(typeChecker.getExpressionType(expr).type);
+    Operand result = type == TypeId::VOID ? Operand() : function().newTemp();
+    emit(OpCode::CALL, type, result, functionOperand(expr->getBinding().symbol),
+         immediateOperand(static_cast<uint32_t>(arguments.size())));
+    return result;
+}
+
+std::string CodeGenerator::getOutput() const {
+    return output.str();
+}
\ No newline at end of file
@@ -1,75 +1,69 @@
-// codegen.h
-#pragma once
-#include "ast.h"
-#include <string>
-#include <vector>
-#include <memory>
-#include <sstream>
-
-enum class OpCode {
-    LOAD,
-    STORE,
-    ADD,
-    SUB,
-    MUL,
-    DIV,
-    CMP,
-    JMP,
-    JE,
-    JNE,
-    JG,
-    JL,
-    CALL,
-    RET,
-    PUSH,
-    POP,
-    PRINT,
-    LABEL
-};
-
-struct Instruction {
-    OpCode opcode;
-    std::string arg1;
-    std::string arg2;
-    std::string result;
-    
-    Instruction(OpCode op, std::string a1 = "", std::string a2 = "", std::string res = "")
-        : opcode(op), arg1(std::move(a1)), arg2(std::move(a2)), result(std::move(res)) {}
-};
-
-class CodeGenerator {
-private:
-    std::vector<Instruction> instructions;
-    int tempVarCounter;
-    int labelCounter;
-    std::ostringstream output;
-    
-    std::string generateTemp();
-    std::string generateLabel();
-    
-    // Code generation methods for expressions
-    void generateExpression(const Expression* expr);
-    void generateBinaryExpression(const BinaryExpression* expr);
-    void generateIdentifier(const IdentifierExpression* expr);
-    void generateLiteral(const LiteralExpression* expr);
-    void generateFunctionCall(const CallExpression* expr);
-    
-    // Code generation methods for statements
-    void generateStatement(const Statement* stmt);
-    void generateBlock(const BlockStatement* stmt);
-    void generateVariableDeclaration(const VariableDeclaration* stmt);
-    void generateFunctionDeclaration(const FunctionDeclaration* stmt);
-    void generateIfStatement(const IfStatement* stmt);
-    void generateWhileStatement(const WhileStatement* stmt);
-    void generateForStatement(const ForStatement* stmt);
-    void generateReturnStatement(const ReturnStatement* stmt);
-    
-public:
-    CodeGenerator();
-    
-    void generate(const std::vector<std::unique_ptr<Statement>>& statements);
-    void optimize();
-    void dumpCode() const;
-    const std::vector<Instruction>& getInstructions() const;
-    std::string getOutput() const;
-}; 
\ No newline at end of file
+// codegen.h
+#pragma once
+#include "ast.h"
+#include "binder.h"
+#include "typechecker.h"
+#include "folder.h"
+#include "ir.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <sstream>
+
+// Lowers the checked and folded AST to IR: one IRFunction per function
+// declaration plus one for top-level initialization code. Operands are
+// integer ids into per-function temps and labels, the symbol list and the
+// program's constant pool.
+class CodeGenerator {
+private:
+    const Binder& binder;
+    const TypeChecker& typeChecker;
+    const ConstantFolder& folder;
+    IRProgram program;
+    size_t current;          // Index of the function being generated
+    std::ostringstream output;
+    
+    IRFunction& function() { return program.functions[current]; }
+    void emit(OpCode op, TypeId type, Operand result = Operand(), Operand arg1 = Operand(), Operand arg2 = Operand());
+    Operand constant(const Constant& value);
+    
+    // Types recorded by the TypeChecker
+    TypeId typeOf(const Expression* expr) const;
+    Operand convert(const Expression* expr, Operand value);
+    
+    // Code generation methods for expressions; each returns the operand holding its value
+    Operand generateExpression(const Expression* expr);
+    Operand generateConstant(const Expression* expr);
+    Operand generateBinaryExpression(const BinaryExpression* expr);
+    Operand generateUnaryExpression(const UnaryExpression* expr);
+    Operand generateLogicalExpression(const LogicalExpression* expr);
+    Operand generateIdentifier(const IdentifierExpression* expr);
+    Operand generateAssignment(const AssignExpression* expr);
+    Operand generateFunctionCall(const CallExpression* expr);
+    
+    // Branches to target if the condition's truth is jumpIfTrue and falls
+    // through otherwise; &&, || and ! become jump chains, not booleans
+    void generateCondition(const Expression* expr, Operand target, bool jumpIfTrue);
+    
+    // Code generation methods for statements
+    void generateStatement(const Statement* stmt);
+    void generateBlock(const BlockStatement* stmt);
+    void generateVariableDeclaration(const VariableDeclaration* stmt);
+    void generateFunctionDeclaration(const FunctionDeclaration* stmt);
+    void generateIfStatement(const IfStatement* stmt);
+    void generateWhileStatement(const WhileStatement* stmt);
+    void generateForStatement(const ForStatement* stmt);
+    void generateReturnStatement(const ReturnStatement* stmt);
+    
+    // Dump helpers
+    std::string operandName(Operand operand) const;
+    
+public:
+    CodeGenerator(const Binder& binder, const TypeChecker& typeChecker, const ConstantFolder& folder);
+    
+    void generate(const std::vector<std::unique_ptr<Statement>>& statements);
+    void dumpCode() const;
+    IRProgram& getProgram() { return program; }
+    const IRProgram& getProgram() const { return program; }
+    std::string getOutput() const;
+};
\ No newline at end of file
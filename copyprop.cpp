@@ -0,0 +1,223 @@
+// copyprop.cpp
+#include "../include/copyprop.h"
+#include "../include/liveness.h"
+#include <unordered_set>
+
+// Follows a chain of copies to the value at its end
+static Operand resolveCopy(std::vector<Operand>& copies, Operand operand) {
+    if (operand.kind != OperandKind::TEMP || copies[operand.id].isNone()) {
+        return operand;
+    }
+    Operand value = resolveCopy(copies, copies[operand.id]);
+    copies[operand.id] = value;
+    return value;
+}
+
+void CopyPropagationPass::runOnFunction(IRFunction& function, IRProgram&) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    std::vector<Instruction>& instructions = function.instructions;
+    std::vector<Operand> copies(function.tempCount + 1);
+    std::vector<bool> removed(instructions.size(), false);
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        if (instr.opcode == OpCode::MOVE && instr.getResult().kind == OperandKind::TEMP) {
+            copies[instr.getResult().id] = instr.getArg1();
+            removed[i] = true;
+        }
+    }
+    
+    // A PHI is a copy once its arguments agree; renaming others can make
+    // more of them agree, so repeat until none changes
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (uint32_t i = 0; i < instructions.size(); ++i) {
+            const Instruction& instr = instructions[i];
+            if (instr.opcode != OpCode::PHI || removed[i]) {
+                continue;
+            }
+            Operand result = instr.getResult();
+            Operand value;
+            bool same = true;
+            for (uint32_t a = instr.getArg1().id; a < instr.getArg1().id + instr.getArg2().id && same; ++a) {
+                Operand argument = resolveCopy(copies, function.phiArguments[a].value);
+                if (argument == result || argument == value) {
+                    continue;
+                }
+                same = value.isNone();
+                value = argument;
+            }
+            // A PHI that only names itself is never reached with a value
+            if (same && !value.isNone()) {
+                copies[result.id] = value;
+                removed[i] = changed = true;
+            }
+        }
+    }
+    
+    for (Instruction& instr : instructions) {
+        if (instr.opcode == OpCode::PHI || instr.opcode == OpCode::LABEL) {
+            continue;
+        }
+        instr.setOperand(Instruction::ARG1, resolveCopy(copies, instr.getArg1()));
+        instr.setOperand(Instruction::ARG2, resolveCopy(copies, instr.getArg2()));
+    }
+    for (PhiArgument& argument : function.phiArguments) {
+        argument.value = resolveCopy(copies, argument.value);
+    }
+    removeInstructions(function, removed);
+}
+
+// Live temps as a sparse set, so each definition visits only the temps live
+// across it rather than every temp of the function
+struct LiveTemps {
+    std::vector<uint32_t> members;
+    std::vector<uint32_t> positions;
+    
+    explicit LiveTemps(uint32_t tempCount) : positions(tempCount + 1, UINT32_MAX) {}
+    
+    void add(uint32_t temp) {
+        if (positions[temp] == UINT32_MAX) {
+            positions[temp] = static_cast<uint32_t>(members.size());
+            members.push_back(temp);
+        }
+    }
+    
+    void remove(uint32_t temp) {
+        uint32_t position = positions[temp];
+        if (position != UINT32_MAX) {
+            members[position] = members.back();
+            positions[members[position]] = position;
+            members.pop_back();
+            positions[temp] = UINT32_MAX;
+        }
+    }
+    
+    void clear() {
+        for (uint32_t temp : members) {
+            positions[temp] = UINT32_MAX;
+        }
+        members.clear();
+    }
+};
+
+// Interference graph over temps whose sets are kept in terms of the
+// representative of each merged class
+struct Coalescer {
+    std::vector<uint32_t> parents;
+    std::vector<std::unordered_set<uint32_t>> neighbors;
+    
+    explicit Coalescer(uint32_t tempCount) : parents(tempCount + 1), neighbors(tempCount + 1) {
+        for (uint32_t temp = 0; temp <= tempCount; ++temp) {
+            parents[temp] = temp;
+        }
+    }
+    
+    uint32_t find(uint32_t temp) {
+        while (parents[temp] != temp) {
+            parents[temp] = parents[parents[temp]];
+            temp = parents[temp];
+        }
+        return temp;
+    }
+    
+    void addInterference(uint32_t a, uint32_t b) {
+        if (a != b) {
+            neighbors[a].insert(b);
+            neighbors[b].insert(a);
+        }
+    }
+    
+    // Merges b into a unless they interfere; returns whether they were merged
+    bool merge(uint32_t a, uint32_t b) {
+        if (a == b) {
+            return true;
+        }
+        if (neighbors[a].count(b)) {
+            return false;
+        }
+        if (neighbors[a].size() < neighbors[b].size()) {
+            std::swap(a, b);
+        }
+        for (uint32_t neighbor : neighbors[b]) {
+            neighbors[neighbor].erase(b);
+            neighbors[neighbor].insert(a);
+            neighbors[a].insert(neighbor);
+        }
+        neighbors[b].clear();
+        parents[b] = a;
+        return true;
+    }
+};
+
+void CoalescingPass::runOnFunction(IRFunction& function, IRProgram&) {
+    if (function.ssa) {
+        return;
+    }
+    
+    ControlFlowGraph cfg(function);
+    Liveness liveness(function, cfg);
+    std::vector<Instruction>& instructions = function.instructions;
+    
+    // A definition interferes with every temp live after it, except the
+    // source of a MOVE, which holds the same value
+    Coalescer coalescer(function.tempCount);
+    LiveTemps live(function.tempCount);
+    for (uint32_t b : cfg.getReversePostorder()) {
+        const BasicBlock& bb = cfg.getBlock(b);
+        live.clear();
+        liveness.getLiveOut(b).forEach([&](uint32_t item) {
+            if (item <= function.tempCount) {
+                live.add(item);
+            }
+        });
+        for (uint32_t i = bb.last; i-- > bb.first;) {
+            const Instruction& instr = instructions[i];
+            if (instr.opcode == OpCode::LABEL) {
+                continue;
+            }
+            Operand result = instr.getResult();
+            if (result.kind == OperandKind::TEMP) {
+                Operand source = instr.opcode == OpCode::MOVE ? instr.getArg1() : Operand();
+                for (uint32_t temp : live.members) {
+                    if (source != tempOperand(temp)) {
+                        coalescer.addInterference(result.id, temp);
+                    }
+                }
+                live.remove(result.id);
+            }
+            for (Operand operand : {instr.getArg1(), instr.getArg2()}) {
+                if (operand.kind == OperandKind::TEMP) {
+                    live.add(operand.id);
+                }
+            }
+        }
+    }
+    
+    for (const Instruction& instr : instructions) {
+        if (instr.opcode == OpCode::MOVE && instr.getResult().kind == OperandKind::TEMP &&
+            instr.getArg1().kind == OperandKind::TEMP) {
+            coalescer.merge(coalescer.find(instr.getResult().id), coalescer.find(instr.getArg1().id));
+        }
+    }
+    
+    // Rename every temp to its class and drop the copies that became empty
+    std::vector<bool> removed(instructions.size(), false);
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        Instruction& instr = instructions[i];
+        if (instr.opcode == OpCode::LABEL) {
+            continue;
+        }
+        for (int o = Instruction::RESULT; o <= Instruction::ARG2; ++o) {
+            Operand operand = instr.getOperand(o);
+            if (operand.kind == OperandKind::TEMP) {
+                instr.setOperand(o, tempOperand(coalescer.find(operand.id)));
+            }
+        }
+        removed[i] = instr.opcode == OpCode::MOVE && instr.getResult() == instr.getArg1();
+    }
+    removeInstructions(function, removed);
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+// copyprop.h
+#pragma once
+#include "optimizer.h"
+
+// Copy propagation on SSA form. Every use of a MOVE's result is renamed to
+// its source, and so is every use of a PHI whose arguments all carry the
+// same value apart from the PHI itself; the copies are then removed.
+class CopyPropagationPass : public FunctionPass {
+public:
+    const char* getName() const override { return "copy-prop"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
+
+// Coalescing of temps after SSA destruction. The source and destination of
+// a MOVE are merged into one temp when their live ranges do not interfere,
+// which leaves the MOVE copying a temp to itself so it can be removed.
+class CoalescingPass : public FunctionPass {
+public:
+    const char* getName() const override { return "coalesce"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+// dataflow.h
+#pragma once
+#include "cfg.h"
+#include <algorithm>
+#include <vector>
+
+enum class DataflowDirection {
+    FORWARD,    // Facts flow from the entry along edges
+    BACKWARD    // Facts flow from the exits against edges
+};
+
+// Lattice and transfer functions of one analysis over basic blocks. Value
+// must be copyable and comparable with ==.
+template <typename Value>
+class DataflowProblem {
+public:
+    virtual ~DataflowProblem() = default;
+    
+    virtual DataflowDirection direction() const = 0;
+    // Value flowing into the entry, or out of the exits when backward
+    virtual Value boundary() const = 0;
+    // Value every other block starts from; the identity of meet
+    virtual Value top() const = 0;
+    // Combines a neighbour's value into another
+    virtual void meet(Value& into, const Value& from) const = 0;
+    // Value on the far side of a block given the value on its near side
+    virtual Value transfer(uint32_t block, const Value& input) const = 0;
+};
+
+// Solution of a problem: the value at the start and at the end of every
+// block in instruction order, whichever the direction
+template <typename Value>
+struct DataflowResult {
+    std::vector<Value> in;
+    std::vector<Value> out;
+};
+
+// Iterates a problem to its fixed point over the reachable blocks with a
+// worklist seeded in reverse postorder, or postorder when backward, so most
+// blocks see their inputs final on the first visit. Unreachable blocks keep
+// top.
+template <typename Value>
+DataflowResult<Value> solveDataflow(const ControlFlowGraph& cfg, const DataflowProblem<Value>& problem) {
+    bool forward = problem.direction() == DataflowDirection::FORWARD;
+    DataflowResult<Value> result{std::vector<Value>(cfg.size(), problem.top()),
+                                 std::vector<Value>(cfg.size(), problem.top())};
+    std::vector<Value>& inputs = forward ? result.in : result.out;
+    std::vector<Value>& outputs = forward ? result.out : result.in;
+    
+    std::vector<uint32_t> worklist(cfg.getReversePostorder());
+    if (forward) {
+        std::reverse(worklist.begin(), worklist.end());   // Popped from the back
+    }
+    std::vector<bool> queued(cfg.size(), false);
+    for (uint32_t block : worklist) {
+        queued[block] = true;
+    }
+    
+    while (!worklist.empty()) {
+        uint32_t block = worklist.back();
+        worklist.pop_back();
+        queued[block] = false;
+        
+        const BasicBlock& bb = cfg.getBlock(block);
+        const std::vector<uint32_t>& sources = forward ? bb.predecessors : bb.successors;
+        bool isBoundary = forward ? block == 0 : bb.successors.empty();
+        Value input = isBoundary ? problem.boundary() : problem.top();
+        for (uint32_t source : sources) {
+            if (cfg.isReachable(source)) {
+                problem.meet(input, outputs[source]);
+            }
+        }
+        inputs[block] = std::move(input);
+        
+        Value output = problem.transfer(block, inputs[block]);
+        if (output == outputs[block]) {
+            continue;
+        }
+        outputs[block] = std::move(output);
+        for (uint32_t target : forward ? bb.successors : bb.predecessors) {
+            if (cfg.isReachable(target) && !queued[target]) {
+                queued[target] = true;
+                worklist.push_back(target);
+            }
+        }
+    }
+    return result;
+}
\ No newline at end of file
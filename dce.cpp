@@ -0,0 +1,123 @@
+// dce.cpp
+#include "../include/dce.h"
+#include "../include/liveness.h"
+
+// Instructions kept for their effect whether or not their result is used
+static bool hasSideEffects(OpCode op) {
+    switch (op) {
+        case OpCode::STORE:
+        case OpCode::CALL:
+        case OpCode::PUSH:
+        case OpCode::RET:
+        case OpCode::JMP:
+        case OpCode::JZ:
+        case OpCode::JNZ:
+        case OpCode::LABEL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Marks what the side effects need and removes the rest
+static void removeDeadValues(IRFunction& function) {
+    std::vector<Instruction>& instructions = function.instructions;
+    std::vector<uint32_t> definitions(function.tempCount + 1, UINT32_MAX);
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        Operand result = instructions[i].getResult();
+        if (result.kind == OperandKind::TEMP) {
+            definitions[result.id] = i;
+        }
+    }
+    
+    std::vector<bool> live(instructions.size(), false);
+    std::vector<bool> used(function.tempCount + 1, false);
+    std::vector<uint32_t> worklist;
+    auto use = [&](Operand operand) {
+        if (operand.kind != OperandKind::TEMP || used[operand.id]) {
+            return;
+        }
+        used[operand.id] = true;
+        uint32_t definition = definitions[operand.id];
+        if (definition != UINT32_MAX && !live[definition]) {
+            live[definition] = true;
+            worklist.push_back(definition);
+        }
+    };
+    
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        if (hasSideEffects(instructions[i].opcode)) {
+            live[i] = true;
+            worklist.push_back(i);
+        }
+    }
+    while (!worklist.empty()) {
+        const Instruction& instr = instructions[worklist.back()];
+        worklist.pop_back();
+        if (instr.opcode == OpCode::PHI) {
+            uint32_t first = instr.getArg1().id;
+            for (uint32_t a = first; a < first + instr.getArg2().id; ++a) {
+                use(function.phiArguments[a].value);
+            }
+        } else if (instr.opcode != OpCode::LABEL) {
+            use(instr.getArg1());
+            use(instr.getArg2());
+        }
+    }
+    
+    for (Instruction& instr : instructions) {
+        if (instr.opcode == OpCode::CALL && instr.getResult().kind == OperandKind::TEMP && !used[instr.getResult().id]) {
+            instr.setOperand(Instruction::RESULT, Operand());
+        }
+    }
+    std::vector<bool> removed(instructions.size());
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        removed[i] = !live[i];
+    }
+    removeInstructions(function, removed);
+}
+
+// Removes pure instructions and local stores whose result is not live;
+// returns whether anything was removed
+static bool removeDeadAssignments(IRFunction& function) {
+    ControlFlowGraph cfg(function);
+    Liveness liveness(function, cfg);
+    
+    // Walk each block backwards from its live-out set
+    std::vector<bool> removed(function.instructions.size(), false);
+    bool anyRemoved = false;
+    for (uint32_t b : cfg.getReversePostorder()) {
+        const BasicBlock& bb = cfg.getBlock(b);
+        BitSet live = liveness.getLiveOut(b);
+        for (uint32_t i = bb.last; i-- > bb.first;) {
+            Instruction& instr = function.instructions[i];
+            int defined = liveness.definedItem(instr);
+            if (defined >= 0 && !live.test(defined)) {
+                if (instr.opcode == OpCode::CALL) {
+                    instr.setOperand(Instruction::RESULT, Operand());
+                } else if (!hasSideEffects(instr.opcode) || instr.opcode == OpCode::STORE) {
+                    removed[i] = anyRemoved = true;
+                    continue;
+                }
+            }
+            if (defined >= 0) {
+                live.reset(defined);
+            }
+            liveness.forEachUse(instr, [&](uint32_t item) { live.set(item); });
+        }
+    }
+    removeInstructions(function, removed);
+    return anyRemoved;
+}
+
+void DeadCodePass::runOnFunction(IRFunction& function, IRProgram&) {
+    removeUnreachableBlocks(function);
+    if (function.ssa) {
+        removeDeadValues(function);
+        return;
+    }
+    
+    // Removing one assignment can make the ones feeding it dead
+    while (removeDeadAssignments(function)) {
+    }
+}
\ No newline at end of file
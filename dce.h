@@ -0,0 +1,16 @@
+// dce.h
+#pragma once
+#include "optimizer.h"
+
+// Dead code elimination. Unreachable blocks are removed first. In SSA form
+// every instruction without side effects is dead unless an instruction that
+// has them needs its value, directly or through other values, which also
+// catches dead cycles of PHIs. Outside SSA form, liveness of temps and local
+// variables decides instead: a pure instruction whose result is not live is
+// dead, and so is a store to a local that is not read again. Calls whose
+// result is never used stay, but drop the result.
+class DeadCodePass : public FunctionPass {
+public:
+    const char* getName() const override { return "dce"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
@@ -0,0 +1,273 @@
+// folder.cpp
+#include "../include/folder.h"
+#include <cmath>
+#include <cstdlib>
+
+ConstantFolder::ConstantFolder(const Binder& binder, const TypeChecker& typeChecker)
+    : binder(binder), typeChecker(typeChecker) {}
+
+void ConstantFolder::fold(const std::vector<std::unique_ptr<Statement>>& statements) {
+    folded.assign(binder.getExpressionCount(), FoldedExpression());
+    for (const auto& stmt : statements) {
+        foldStatement(stmt.get());
+    }
+}
+
+void ConstantFolder::foldExpression(const Expression* expr) {
+    if (!expr) {
+        return;
+    }
+
+    // Operands are folded first, so each expression sees their results
+    FoldedExpression& result = folded[expr->getId()];
+    if (auto* literalExpr = dynamic_cast<const LiteralExpression*>(expr)) {
+        result.value = foldLiteral(literalExpr);
+    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        foldExpression(unaryExpr->getOperand());
+        result = foldUnary(unaryExpr);
+    } else if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        foldExpression(binaryExpr->getLeft());
+        foldExpression(binaryExpr->getRight());
+        result = foldBinary(binaryExpr);
+    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        foldExpression(logicalExpr->getLeft());
+        foldExpression(logicalExpr->getRight());
+        result = foldLogical(logicalExpr);
+    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
+        foldExpression(assignExpr->getValue());
+    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
+        for (const auto& arg : callExpr->getArguments()) {
+            foldExpression(arg.get());
+        }
+    }
+}
+
+Constant ConstantFolder::foldLiteral(const LiteralExpression* expr) const {
+    Constant value;
+    const std::string& spelling = expr->getValue();
+    switch (typeIdOf(expr->getLiteralType())) {
+        case TypeId::INT:
+            value.integer = wrapInteger(std::strtoll(spelling.c_str(), nullptr, 10));
+            break;
+        case TypeId::FLOAT:
+            value.real = std::strtof(spelling.c_str(), nullptr);
+            break;
+        case TypeId::BOOL:
+            value.integer = spelling == "true";
+            break;
+        case TypeId::CHAR:
+            value.integer = spelling.empty() ? 0 : static_cast<unsigned char>(spelling[0]);
+            break;
+        case TypeId::STRING:
+            value.text = spelling;
+            break;
+        default:
+            return value;
+    }
+    value.type = typeIdOf(expr->getLiteralType());
+    return value;
+}
+
+FoldedExpression ConstantFolder::foldUnary(const UnaryExpression* expr) const {
+    FoldedExpression result;
+    const Expression* operand = expr->getOperand();
+    Constant value = convertedValue(operand);
+
+    switch (expr->getOperator()) {
+        case TokenType::MINUS:
+            if (value.type == TypeId::INT) {
+                result.value = value;
+                result.value.integer = wrapInteger(-static_cast<int64_t>(value.integer));
+            } else if (value.type == TypeId::FLOAT) {
+                result.value = value;
+                result.value.real = -value.real;
+            }
+            break;
+
+        case TokenType::PLUS:
+            if (isNumericType(typeOf(operand))) {
+                result.value = value;
+                result.replacement = value.isConstant() ? nullptr : operand;
+            }
+            break;
+
+        case TokenType::NOT:
+            if (value.type == TypeId::BOOL) {
+                result.value = value;
+                result.value.integer = !value.integer;
+            } else if (auto* inner = dynamic_cast<const UnaryExpression*>(operand)) {
+                // !!b is b for a boolean b
+                if (inner->getOperator() == TokenType::NOT && typeOf(inner->getOperand()) == TypeId::BOOL) {
+                    result.replacement = inner->getOperand();
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+    return result;
+}
+
+FoldedExpression ConstantFolder::foldBinary(const BinaryExpression* expr) const {
+    FoldedExpression result;
+    const Expression* left = expr->getLeft();
+    const Expression* right = expr->getRight();
+    TokenType op = expr->getOperator();
+    TypeId type = typeOf(expr);
+
+    // Operands have been converted to their common type
+    Constant l = convertedValue(left);
+    Constant r = convertedValue(right);
+    Constant& value = result.value;
+
+    if (l.isConstant() && r.isConstant()) {
+        value = evaluateBinary(op, type, l, r);
+        if (value.isConstant()) {
+            return result;
+        }
+    }
+
+    // Algebraic identities; an operand replaces the expression only if it
+    // needs no conversion, and is only dropped if evaluating it has no effect
+    switch (op) {
+        case TokenType::PLUS:
+            if (type == TypeId::INT && isZero(r) && isIdentity(left, expr)) {
+                result.replacement = left;
+            } else if (type == TypeId::INT && isZero(l) && isIdentity(right, expr)) {
+                result.replacement = right;
+            }
+            break;
+        case TokenType::MINUS:
+            if (isZero(r) && isIdentity(left, expr)) {
+                result.replacement = left;
+            }
+            break;
+        case TokenType::MULTIPLY:
+            if (isOne(r) && isIdentity(left, expr)) {
+                result.replacement = left;
+            } else if (isOne(l) && isIdentity(right, expr)) {
+                result.replacement = right;
+            } else if (type == TypeId::INT && ((isZero(r) && !hasSideEffects(left)) ||
+                                               (isZero(l) && !hasSideEffects(right)))) {
+                value.type = TypeId::INT;
+                value.integer = 0;
+            }
+            break;
+        case TokenType::SLASH:
+            if (isOne(r) && isIdentity(left, expr)) {
+                result.replacement = left;
+            }
+            break;
+        default:
+            break;
+    }
+    return result;
+}
+
+FoldedExpression ConstantFolder::foldLogical(const LogicalExpression* expr) const {
+    FoldedExpression result;
+    const Expression* left = expr->getLeft();
+    const Expression* right = expr->getRight();
+    Constant l = convertedValue(left);
+    Constant r = convertedValue(right);
+    bool isAnd = expr->getOperator() == TokenType::AND;
+
+    if (l.type == TypeId::BOOL) {
+        // false && x and true || x short-circuit; otherwise the right operand decides
+        if (l.isTrue() != isAnd) {
+            result.value = l;
+        } else if (r.type == TypeId::BOOL) {
+            result.value = r;
+        } else {
+            result.replacement = right;
+        }
+    } else if (r.type == TypeId::BOOL) {
+        if (r.isTrue() == isAnd) {
+            result.replacement = left;
+        } else if (!hasSideEffects(left)) {
+            result.value = r;
+        }
+    }
+    return result;
+}
+
+void ConstantFolder::foldStatement(const Statement* stmt) {
+    if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
+        foldExpression(exprStmt->getExpression());
+    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
+        for (const auto& statement : blockStmt->getStatements()) {
+            foldStatement(statement.get());
+        }
+    } else if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
+        foldExpression(varDecl->getInitializer());
+    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
+        foldStatement(funcDecl->getBody());
+    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
+        foldExpression(ifStmt->getCondition());
+        foldStatement(ifStmt->getThenBranch());
+        if (ifStmt->getElseBranch()) {
+            foldStatement(ifStmt->getElseBranch());
+        }
+    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
+        foldExpression(whileStmt->getCondition());
+        foldStatement(whileStmt->getBody());
+    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
+        if (forStmt->getInitializer()) {
+            foldStatement(forStmt->getInitializer());
+        }
+        foldExpression(forStmt->getCondition());
+        foldExpression(forStmt->getIncrement());
+        foldStatement(forStmt->getBody());
+    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
+        foldExpression(returnStmt->getValue());
+    }
+}
+
+TypeId ConstantFolder::typeOf(const Expression* expr) const {
+    return binder.getTypes().kindOf(typeChecker.getExpressionType(expr).type);
+}
+
+TypeId ConstantFolder::convertedTypeOf(const Expression* expr) const {
+    return binder.getTypes().kindOf(typeChecker.getExpressionType(expr).converted);
+}
+
+Constant ConstantFolder::convertedValue(const Expression* expr) const {
+    const Constant& value = getConstant(expr);
+    return value.isConstant() ? convertConstant(value, convertedTypeOf(expr)) : value;
+}
+
+bool ConstantFolder::isIdentity(const Expression* operand, const Expression* expr) const {
+    return typeOf(operand) == typeOf(expr) && convertedTypeOf(operand) == typeOf(expr);
+}
+
+bool ConstantFolder::hasSideEffects(const Expression* expr) {
+    if (!expr) {
+        return false;
+    }
+    if (dynamic_cast<const AssignExpression*>(expr) || dynamic_cast<const CallExpression*>(expr)) {
+        return true;
+    }
+    if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        TokenType op = unaryExpr->getOperator();
+        return op == TokenType::INCREMENT || op == TokenType::DECREMENT || hasSideEffects(unaryExpr->getOperand());
+    }
+    if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        return hasSideEffects(binaryExpr->getLeft()) || hasSideEffects(binaryExpr->getRight());
+    }
+    if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        return hasSideEffects(logicalExpr->getLeft()) || hasSideEffects(logicalExpr->getRight());
+    }
+    return false;
+}
+
+bool ConstantFolder::isZero(const Constant& value) {
+    // -0.0 is not an identity for floats
+    return (value.type == TypeId::INT && value.integer == 0) ||
+           (value.type == TypeId::FLOAT && value.real == 0.0f && !std::signbit(value.real));
+}
+
+bool ConstantFolder::isOne(const Constant& value) {
+    return (value.type == TypeId::INT && value.integer == 1) ||
+           (value.type == TypeId::FLOAT && value.real == 1.0f);
+}
\ No newline at end of file
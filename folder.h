@@ -0,0 +1,52 @@
+// folder.h
+#pragma once
+#include "ast.h"
+#include "binder.h"
+#include "typechecker.h"
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// What an expression folds to
+struct FoldedExpression {
+    Constant value;                           // The whole expression is this constant
+    const Expression* replacement = nullptr;  // Or it reduces to this operand, e.g. x for x * 1
+};
+
+// Constant folding and algebraic simplification. Runs between type checking
+// and code generation and leaves the AST as written: results are recorded by
+// expression id, and the code generator emits folded values in place of the
+// expressions and skips branches whose condition is constant.
+class ConstantFolder {
+private:
+    const Binder& binder;
+    const TypeChecker& typeChecker;
+    std::vector<FoldedExpression> folded;
+
+    // Folding methods for expressions
+    void foldExpression(const Expression* expr);
+    Constant foldLiteral(const LiteralExpression* expr) const;
+    FoldedExpression foldUnary(const UnaryExpression* expr) const;
+    FoldedExpression foldBinary(const BinaryExpression* expr) const;
+    FoldedExpression foldLogical(const LogicalExpression* expr) const;
+
+    // Folding methods for statements
+    void foldStatement(const Statement* stmt);
+
+    // Utility methods
+    TypeId typeOf(const Expression* expr) const;
+    TypeId convertedTypeOf(const Expression* expr) const;
+    Constant convertedValue(const Expression* expr) const;
+    bool isIdentity(const Expression* operand, const Expression* expr) const;
+    static bool hasSideEffects(const Expression* expr);
+    static bool isZero(const Constant& value);
+    static bool isOne(const Constant& value);
+
+public:
+    ConstantFolder(const Binder& binder, const TypeChecker& typeChecker);
+
+    void fold(const std::vector<std::unique_ptr<Statement>>& statements);
+    const FoldedExpression& getFolded(const Expression* expr) const { return folded[expr->getId()]; }
+    const Constant& getConstant(const Expression* expr) const { return folded[expr->getId()].value; }
+};
\ No newline at end of file
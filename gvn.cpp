@@ -0,0 +1,169 @@
+// gvn.cpp
+#include "../include/gvn.h"
+#include <unordered_map>
+
+// An expression whose value can be reused
+struct ExpressionKey {
+    OpCode opcode;
+    TypeId type;
+    Operand left;
+    Operand right;
+    uint32_t generation;   // Memory generation for loads, 0 otherwise
+    
+    bool operator==(const ExpressionKey& other) const {
+        return opcode == other.opcode && type == other.type && left == other.left &&
+               right == other.right && generation == other.generation;
+    }
+};
+
+struct ExpressionKeyHash {
+    size_t operator()(const ExpressionKey& key) const {
+        size_t seed = static_cast<size_t>(key.opcode) << 8 | static_cast<size_t>(key.type);
+        for (uint32_t value : {static_cast<uint32_t>(key.left.kind), key.left.id,
+                               static_cast<uint32_t>(key.right.kind), key.right.id, key.generation}) {
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
+// State of value numbering over one function
+struct ValueNumbering {
+    IRFunction& function;
+    const ControlFlowGraph& cfg;
+    std::vector<Operand> leaders;                     // Value of each temp, if it was found redundant
+    std::unordered_map<ExpressionKey, Operand, ExpressionKeyHash> available;
+    std::vector<ExpressionKey> scopeKeys;             // Keys added, innermost scope last
+    std::vector<bool> removed;
+    uint32_t generations = 0;
+    
+    ValueNumbering(IRFunction& function, const ControlFlowGraph& cfg);
+    
+    Operand leaderOf(Operand operand);
+    void makeAvailable(const ExpressionKey& key, Operand value);
+    void visit(uint32_t block, uint32_t generation);
+    void rewrite();
+};
+
+static bool isCommutative(OpCode op) {
+    return op == OpCode::ADD || op == OpCode::MUL || op == OpCode::CMPEQ || op == OpCode::CMPNE;
+}
+
+// Canonical order for commutative operands
+static bool operandLess(Operand a, Operand b) {
+    return a.kind != b.kind ? a.kind < b.kind : a.id < b.id;
+}
+
+ValueNumbering::ValueNumbering(IRFunction& function, const ControlFlowGraph& cfg)
+    : function(function), cfg(cfg), leaders(function.tempCount + 1), removed(function.instructions.size(), false) {}
+
+Operand ValueNumbering::leaderOf(Operand operand) {
+    if (operand.kind != OperandKind::TEMP || leaders[operand.id].isNone()) {
+        return operand;
+    }
+    
+    // Leaders are never themselves replaced later, but chains can form
+    // through values found equal to a replaced temp
+    Operand leader = leaderOf(leaders[operand.id]);
+    leaders[operand.id] = leader;
+    return leader;
+}
+
+void ValueNumbering::makeAvailable(const ExpressionKey& key, Operand value) {
+    if (available.emplace(key, value).second) {
+        scopeKeys.push_back(key);
+    }
+}
+
+void ValueNumbering::visit(uint32_t block, uint32_t generation) {
+    size_t scopeStart = scopeKeys.size();
+    const BasicBlock& bb = cfg.getBlock(block);
+    
+    // Another path may have written memory before a join point
+    if (bb.predecessors.size() != 1) {
+        generation = ++generations;
+    }
+    
+    for (uint32_t i = bb.first; i < bb.last; ++i) {
+        Instruction& instr = function.instructions[i];
+        Operand left = leaderOf(instr.getArg1());
+        Operand right = leaderOf(instr.getArg2());
+        Operand result = instr.getResult();
+        
+        switch (instr.opcode) {
+            case OpCode::STORE:
+                generation = ++generations;
+                makeAvailable({OpCode::LOAD, instr.type, result, Operand(), generation}, left);
+                continue;
+            
+            case OpCode::CALL:
+                generation = ++generations;
+                continue;
+            
+            case OpCode::LOAD:
+            case OpCode::MOVE:
+            case OpCode::ADD:
+            case OpCode::SUB:
+            case OpCode::MUL:
+            case OpCode::DIV:
+            case OpCode::CMPEQ:
+            case OpCode::CMPNE:
+            case OpCode::CMPLT:
+            case OpCode::CMPLE:
+            case OpCode::CMPGT:
+            case OpCode::CMPGE:
+            case OpCode::ITOF:
+            case OpCode::FTOI:
+                break;
+            
+            default:
+                continue;
+        }
+        
+        if (isCommutative(instr.opcode) && operandLess(right, left)) {
+            std::swap(left, right);
+        }
+        ExpressionKey key{instr.opcode, instr.type, left, right, instr.opcode == OpCode::LOAD ? generation : 0};
+        auto it = available.find(key);
+        if (it != available.end()) {
+            leaders[result.id] = it->second;
+            removed[i] = true;
+        } else {
+            makeAvailable(key, result);
+        }
+    }
+    
+    for (uint32_t child : cfg.getDominatorChildren(block)) {
+        visit(child, generation);
+    }
+    
+    while (scopeKeys.size() > scopeStart) {
+        available.erase(scopeKeys.back());
+        scopeKeys.pop_back();
+    }
+}
+
+void ValueNumbering::rewrite() {
+    for (Instruction& instr : function.instructions) {
+        if (instr.opcode == OpCode::PHI || instr.opcode == OpCode::LABEL) {
+            continue;
+        }
+        instr.setOperand(Instruction::ARG1, leaderOf(instr.getArg1()));
+        instr.setOperand(Instruction::ARG2, leaderOf(instr.getArg2()));
+    }
+    for (PhiArgument& argument : function.phiArguments) {
+        argument.value = leaderOf(argument.value);
+    }
+    removeInstructions(function, removed);
+}
+
+void GVNPass::runOnFunction(IRFunction& function, IRProgram&) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    ControlFlowGraph cfg(function);
+    ValueNumbering numbering(function, cfg);
+    numbering.visit(0, 0);
+    numbering.rewrite();
+}
\ No newline at end of file
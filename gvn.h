@@ -0,0 +1,19 @@
+// gvn.h
+#pragma once
+#include "optimizer.h"
+
+// Dominator-scoped global value numbering on SSA form. Walks the dominator
+// tree with a scoped table of available expressions keyed by opcode, type
+// and value-numbered operands; an instruction whose expression is already
+// available from a dominating block is removed and its uses renamed to the
+// earlier value. Commutative operands are put in a canonical order.
+//
+// Loads of globals are available only within one memory generation: a new
+// generation starts at every store and call, and at every block with more
+// than one predecessor, where another path may have written memory. A store
+// makes its value available to later loads of the same variable.
+class GVNPass : public FunctionPass {
+public:
+    const char* getName() const override { return "gvn"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
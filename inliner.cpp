@@ -0,0 +1,198 @@
+// inliner.cpp
+#include "../include/inliner.h"
+#include "../include/callgraph.h"
+#include <unordered_set>
+
+// Instructions a function runs or takes space for, leaving out labels
+static uint32_t functionSize(const IRFunction& function) {
+    uint32_t size = 0;
+    for (const Instruction& instr : function.instructions) {
+        size += instr.opcode != OpCode::LABEL;
+    }
+    return size;
+}
+
+// Whether the call at the given index is worth inlining, with its
+// arguments pushed right before it
+static bool shouldInline(const IRFunction& caller, const IRFunction& callee, uint32_t call, uint32_t calleeSize,
+                         uint32_t loopDepth) {
+    const Instruction& instr = caller.instructions[call];
+    uint32_t argumentCount = instr.getArg2().id;
+    if (callee.ssa || argumentCount != callee.parameters.size() || argumentCount > call ||
+        (!instr.getResult().isNone() && callee.returnValue.type == TypeId::VOID)) {
+        return false;
+    }
+    
+    uint32_t allowed = INLINE_THRESHOLD + INLINE_LOOP_BONUS * std::min(loopDepth, INLINE_MAX_LOOP_DEPTH);
+    for (uint32_t i = call - argumentCount; i < call; ++i) {
+        const Instruction& push = caller.instructions[i];
+        if (push.opcode != OpCode::PUSH) {
+            return false;
+        }
+        if (push.getArg1().kind == OperandKind::CONSTANT) {
+            allowed += INLINE_CONSTANT_BONUS;
+        }
+    }
+    uint32_t saved = argumentCount + 2;
+    return calleeSize <= allowed + saved;
+}
+
+// Appends the callee's body in place of a call, with its temps and labels
+// moved past those of the caller
+static void appendInlined(IRFunction& caller, const IRFunction& callee, const Instruction& call,
+                          const Operand* arguments, ConstantPool& constants, std::vector<Instruction>& out) {
+    uint32_t tempBase = caller.tempCount;
+    uint32_t labelBase = caller.labelCount;
+    caller.tempCount += callee.tempCount;
+    caller.labelCount += callee.labelCount;
+    Operand exit = caller.newLabel();
+    Operand result = variableOperand(callee.returnValue.symbol);
+    
+    for (uint32_t i = 0; i < callee.parameters.size(); ++i) {
+        out.emplace_back(OpCode::STORE, callee.parameters[i].type, variableOperand(callee.parameters[i].symbol),
+                         arguments[i]);
+    }
+    
+    // Locals start out as zero in every call, not with what the copy before
+    // left in them; stores the body overwrites are removed later
+    for (const IRVariable& local : callee.locals) {
+        Constant zero;
+        zero.type = local.type;
+        out.emplace_back(OpCode::STORE, local.type, variableOperand(local.symbol),
+                         constantOperand(constants.intern(zero)));
+    }
+    for (uint32_t i = 0; i < callee.instructions.size(); ++i) {
+        Instruction copy = callee.instructions[i];
+        for (int o = Instruction::RESULT; o <= Instruction::ARG2; ++o) {
+            Operand operand = copy.getOperand(o);
+            if (operand.kind == OperandKind::TEMP) {
+                copy.setOperand(o, tempOperand(operand.id + tempBase));
+            } else if (operand.kind == OperandKind::LABEL) {
+                copy.setOperand(o, Operand(OperandKind::LABEL, operand.id + labelBase));
+            }
+        }
+        if (copy.opcode != OpCode::RET) {
+            out.push_back(copy);
+            continue;
+        }
+        
+        // A return leaves its value behind and jumps past the copy, unless
+        // it ends the body
+        if (!copy.getArg1().isNone() && !call.getResult().isNone()) {
+            out.emplace_back(OpCode::STORE, call.type, result, copy.getArg1());
+        }
+        if (i + 1 < callee.instructions.size()) {
+            out.emplace_back(OpCode::JMP, TypeId::VOID, Operand(), exit);
+        }
+    }
+    out.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), exit);
+    if (!call.getResult().isNone()) {
+        out.emplace_back(OpCode::LOAD, call.type, call.getResult(), result);
+    }
+}
+
+// Inlines the calls of one function that the cost model accepts; returns
+// whether there were any
+static bool inlineCalls(IRFunction& caller, IRProgram& program, const CallGraph& callGraph,
+                        const std::vector<uint32_t>& sizes, uint32_t callerSize) {
+    // Calls are chosen in order until the caller's budget runs out
+    std::vector<Instruction>& instructions = caller.instructions;
+    std::vector<int> inlined(instructions.size(), -1);   // Callee replacing each chosen call
+    std::vector<uint32_t> loopDepths;
+    std::vector<uint32_t> blockOf;
+    uint32_t limit = callerSize + std::max(callerSize, INLINE_GROWTH_BUDGET);
+    uint32_t size = callerSize;
+    bool changed = false;
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        int callee = instr.opcode == OpCode::CALL ? callGraph.functionOf(instr.getArg1().id) : -1;
+        if (callee < 0 || callGraph.isRecursive(callee) || size + sizes[callee] > limit) {
+            continue;
+        }
+        
+        // Loop depths are found once, at the first call worth a look
+        if (loopDepths.empty()) {
+            ControlFlowGraph cfg(caller);
+            loopDepths = cfg.computeLoopDepths();
+            blockOf.assign(instructions.size(), 0);
+            for (uint32_t b = 0; b < cfg.size(); ++b) {
+                for (uint32_t j = cfg.getBlock(b).first; j < cfg.getBlock(b).last; ++j) {
+                    blockOf[j] = b;
+                }
+            }
+        }
+        if (shouldInline(caller, program.functions[callee], i, sizes[callee], loopDepths[blockOf[i]])) {
+            inlined[i] = callee;
+            size += sizes[callee];
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+    
+    // The callee's parameters, locals and return value become locals of the
+    // caller
+    std::unordered_set<uint32_t> variables;
+    for (const auto* list : {&caller.parameters, &caller.locals}) {
+        for (const IRVariable& variable : *list) {
+            variables.insert(variable.symbol);
+        }
+    }
+    auto addLocal = [&](uint32_t symbol, TypeId type) {
+        if (variables.insert(symbol).second) {
+            caller.locals.push_back({symbol, type});
+        }
+    };
+    
+    std::vector<Instruction> rewritten;
+    rewritten.reserve(size + instructions.size() / 8);
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        if (inlined[i] < 0) {
+            rewritten.push_back(instr);
+            continue;
+        }
+        
+        // The arguments were pushed right before the call
+        const IRFunction& callee = program.functions[inlined[i]];
+        uint32_t argumentCount = instr.getArg2().id;
+        std::vector<Operand> arguments;
+        for (uint32_t j = i - argumentCount; j < i; ++j) {
+            arguments.push_back(instructions[j].getArg1());
+        }
+        rewritten.erase(rewritten.end() - argumentCount, rewritten.end());
+        appendInlined(caller, callee, instr, arguments.data(), program.constants, rewritten);
+        
+        for (const auto* list : {&callee.parameters, &callee.locals}) {
+            for (const IRVariable& variable : *list) {
+                addLocal(variable.symbol, variable.type);
+            }
+        }
+        if (!instr.getResult().isNone()) {
+            addLocal(callee.returnValue.symbol, callee.returnValue.type);
+        }
+    }
+    instructions = std::move(rewritten);
+    return true;
+}
+
+void InliningPass::run(IRProgram& program) {
+    CallGraph callGraph(program);
+    std::vector<uint32_t> sizes(program.functions.size());
+    for (uint32_t f = 0; f < program.functions.size(); ++f) {
+        sizes[f] = functionSize(program.functions[f]);
+    }
+    
+    // Inlining a function that is not recursive leaves the graph's
+    // components as they are, so one graph serves the whole pass
+    for (uint32_t f : callGraph.getBottomUpOrder()) {
+        IRFunction& function = program.functions[f];
+        if (function.symbol < 0 || function.ssa) {
+            continue;
+        }
+        if (inlineCalls(function, program, callGraph, sizes, sizes[f])) {
+            sizes[f] = functionSize(function);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+// inliner.h
+#pragma once
+#include "optimizer.h"
+
+// Cost model of inlining, in instructions
+constexpr uint32_t INLINE_THRESHOLD = 24;        // Callee size inlined at any call site
+constexpr uint32_t INLINE_CONSTANT_BONUS = 8;    // Extra size allowed per constant argument
+constexpr uint32_t INLINE_LOOP_BONUS = 16;       // Extra size allowed per loop around the call
+constexpr uint32_t INLINE_MAX_LOOP_DEPTH = 3;    // Deepest loop nesting that adds to the bonus
+constexpr uint32_t INLINE_GROWTH_BUDGET = 256;   // Least a caller may grow by
+
+// Replaces calls to small functions with a copy of their body, before SSA
+// construction. Arguments are stored to the callee's parameters, which
+// become locals of the caller like the callee's own locals, and those
+// locals are set to zero as a call would leave them; each return
+// stores its value to the callee's hidden return value variable, another
+// such local, and jumps past the copy, where the call's result is loaded.
+//
+// A call site is inlined when the callee's size, less the PUSH, CALL and
+// RET instructions that go away, is within INLINE_THRESHOLD, raised for
+// each constant argument, which later passes can fold into the body, and
+// for each loop around the call. A caller grows by no more than its size
+// or INLINE_GROWTH_BUDGET, whichever is larger.
+//
+// Functions are visited bottom-up in the call graph, so callees are inlined
+// into after their own calls have been inlined. Recursive functions are
+// never inlined, and calls from top-level code, which runs once, are left
+// alone.
+class InliningPass : public Pass {
+public:
+    const char* getName() const override { return "inline"; }
+    void run(IRProgram& program) override;
+};
\ No newline at end of file
@@ -0,0 +1,276 @@
+// interpreter.cpp
+#include "../include/interpreter.h"
+#include <algorithm>
+
+// Limits that turn runaway recursion and loops into errors
+constexpr uint32_t MAX_CALL_DEPTH = 4096;
+constexpr uint64_t MAX_STEPS = 200000000;
+
+static bool isTrue(const Constant& value) {
+    return value.type == TypeId::FLOAT ? value.real != 0.0f : value.integer != 0;
+}
+
+static Constant arithmetic(OpCode op, TypeId type, const Constant& left, const Constant& right) {
+    Constant value;
+    value.type = type;
+    if (type == TypeId::FLOAT) {
+        value.real = op == OpCode::ADD ? left.real + right.real :
+                     op == OpCode::SUB ? left.real - right.real :
+                     op == OpCode::MUL ? left.real * right.real : left.real / right.real;
+    } else if (type == TypeId::STRING) {
+        if (op != OpCode::ADD) {
+            throw RuntimeError(std::string("cannot execute ") + opcodeName(op) + " on strings");
+        }
+        value.text = left.text + right.text;
+    } else {
+        int64_t a = left.integer;
+        int64_t b = right.integer;
+        if (op == OpCode::DIV && b == 0) {
+            throw RuntimeError("division by zero");
+        }
+        value.integer = wrapInteger(op == OpCode::ADD ? a + b :
+                                    op == OpCode::SUB ? a - b :
+                                    op == OpCode::MUL ? a * b : a / b);
+    }
+    return value;
+}
+
+static Constant compare(OpCode op, TypeId type, const Constant& left, const Constant& right) {
+    int order;
+    if (type == TypeId::FLOAT) {
+        order = left.real < right.real ? -1 : left.real > right.real ? 1 : 0;
+    } else if (type == TypeId::STRING) {
+        order = left.text.compare(right.text);
+    } else {
+        order = left.integer < right.integer ? -1 : left.integer > right.integer ? 1 : 0;
+    }
+    Constant value;
+    value.type = TypeId::BOOL;
+    switch (op) {
+        case OpCode::CMPEQ: value.integer = order == 0; break;
+        case OpCode::CMPNE: value.integer = order != 0; break;
+        case OpCode::CMPLT: value.integer = order < 0; break;
+        case OpCode::CMPLE: value.integer = order <= 0; break;
+        case OpCode::CMPGT: value.integer = order > 0; break;
+        default: value.integer = order >= 0; break;
+    }
+    return value;
+}
+
+Interpreter::Interpreter(const IRProgram& program) : program(program) {
+    for (uint32_t f = 0; f < program.functions.size(); ++f) {
+        if (program.functions[f].symbol >= 0) {
+            functionIndex.emplace(static_cast<uint32_t>(program.functions[f].symbol), f);
+        }
+    }
+}
+
+Constant Interpreter::run(uint32_t entry) {
+    for (uint32_t f = 0; f < program.functions.size(); ++f) {
+        if (program.functions[f].symbol < 0) {
+            call(f, {});
+        }
+    }
+    auto it = functionIndex.find(entry);
+    if (it == functionIndex.end()) {
+        throw RuntimeError("entry function has no body");
+    }
+    return call(it->second, {});
+}
+
+Constant Interpreter::call(uint32_t index, const std::vector<Constant>& arguments) {
+    const IRFunction& function = program.functions[index];
+    if (++depth > MAX_CALL_DEPTH) {
+        throw RuntimeError("calls nested deeper than " + std::to_string(MAX_CALL_DEPTH));
+    }
+    
+    // Storage of each temp: the temp itself, or once registers are allocated
+    // the register or spill slot it was placed in. Slot 0 takes the values of
+    // temps that were given no location.
+    uint32_t registerCount = 0;
+    for (const Location& location : function.locations) {
+        if (location.kind == LocationKind::REGISTER) {
+            registerCount = std::max(registerCount, location.index + 1);
+        }
+    }
+    auto slotOf = [&](Operand temp) -> size_t {
+        if (function.locations.empty()) {
+            return temp.id;
+        }
+        const Location& location = function.locations[temp.id];
+        switch (location.kind) {
+            case LocationKind::REGISTER: return 1 + location.index;
+            case LocationKind::SPILL: return 1 + registerCount + location.index;
+            default: return 0;
+        }
+    };
+    std::vector<Constant> temps(function.locations.empty() ? function.tempCount + 1
+                                                           : 1 + registerCount + function.spillSlots);
+    auto valueOf = [&](Operand operand) -> const Constant& {
+        return operand.kind == OperandKind::CONSTANT ? program.constants.get(operand.id) : temps[slotOf(operand)];
+    };
+    
+    // Locals start out as zero of their type, like globals
+    std::unordered_map<uint32_t, Constant> locals;
+    for (const std::vector<IRVariable>* variables : {&function.parameters, &function.locals}) {
+        for (const IRVariable& variable : *variables) {
+            locals[variable.symbol].type = variable.type;
+        }
+    }
+    for (size_t i = 0; i < function.parameters.size() && i < arguments.size(); ++i) {
+        locals[function.parameters[i].symbol] = arguments[i];
+    }
+    auto variable = [&](uint32_t symbol) -> Constant& {
+        auto it = locals.find(symbol);
+        return it != locals.end() ? it->second : globals[symbol];
+    };
+    
+    std::vector<size_t> labelAt(function.labelCount + 1, 0);
+    for (size_t i = 0; i < function.instructions.size(); ++i) {
+        if (function.instructions[i].opcode == OpCode::LABEL) {
+            labelAt[function.instructions[i].getArg1().id] = i;
+        }
+    }
+    
+    // PHIs pick their value by the label that started the block executed
+    // before the current one, 0 for a block without a label
+    uint32_t block = 0;
+    uint32_t previous = 0;
+    std::vector<Constant> pushed;
+    std::vector<Constant> incoming;
+    size_t pc = 0;
+    while (pc < function.instructions.size()) {
+        const Instruction& instr = function.instructions[pc++];
+        if (instr.opcode != OpCode::LABEL && instr.opcode != OpCode::PHI && ++steps > MAX_STEPS) {
+            throw RuntimeError("more than " + std::to_string(MAX_STEPS) + " instructions executed");
+        }
+        switch (instr.opcode) {
+            case OpCode::LOAD: {
+                Constant value = variable(instr.getArg1().id);
+                if (!value.isConstant()) {
+                    value = Constant();
+                    value.type = instr.type;
+                }
+                temps[slotOf(instr.getResult())] = value;
+                break;
+            }
+            case OpCode::STORE:
+                variable(instr.getResult().id) = valueOf(instr.getArg1());
+                break;
+            
+            case OpCode::ADD:
+            case OpCode::SUB:
+            case OpCode::MUL:
+            case OpCode::DIV:
+                temps[slotOf(instr.getResult())] =
+                    arithmetic(instr.opcode, instr.type, valueOf(instr.getArg1()), valueOf(instr.getArg2()));
+                break;
+            
+            case OpCode::CMPEQ:
+            case OpCode::CMPNE:
+            case OpCode::CMPLT:
+            case OpCode::CMPLE:
+            case OpCode::CMPGT:
+            case OpCode::CMPGE:
+                temps[slotOf(instr.getResult())] =
+                    compare(instr.opcode, instr.type, valueOf(instr.getArg1()), valueOf(instr.getArg2()));
+                break;
+            
+            case OpCode::JMP:
+                pc = labelAt[instr.getArg1().id];
+                break;
+            
+            case OpCode::JZ:
+            case OpCode::JNZ:
+                if (isTrue(valueOf(instr.getArg1())) == (instr.opcode == OpCode::JNZ)) {
+                    pc = labelAt[instr.getArg2().id];
+                } else if (pc < function.instructions.size() && function.instructions[pc].opcode != OpCode::LABEL) {
+                    previous = block;
+                    block = 0;
+                }
+                break;
+            
+            case OpCode::PUSH:
+                pushed.push_back(valueOf(instr.getArg1()));
+                break;
+            
+            case OpCode::CALL: {
+                auto callee = functionIndex.find(instr.getArg1().id);
+                if (callee == functionIndex.end()) {
+                    throw RuntimeError("call to a function without a body");
+                }
+                std::vector<Constant> values(pushed.end() - instr.getArg2().id, pushed.end());
+                pushed.resize(pushed.size() - values.size());
+                Constant result = call(callee->second, values);
+                if (!instr.getResult().isNone()) {
+                    temps[slotOf(instr.getResult())] = result;
+                }
+                break;
+            }
+            case OpCode::RET: {
+                Constant result;
+                result.type = TypeId::VOID;
+                if (!instr.getArg1().isNone()) {
+                    result = valueOf(instr.getArg1());
+                }
+                --depth;
+                return result;
+            }
+            case OpCode::LABEL:
+                previous = block;
+                block = instr.getArg1().id;
+                break;
+            
+            case OpCode::ITOF: {
+                Constant value;
+                value.type = TypeId::FLOAT;
+                value.real = static_cast<float>(valueOf(instr.getArg1()).integer);
+                temps[slotOf(instr.getResult())] = value;
+                break;
+            }
+            case OpCode::FTOI: {
+                float real = valueOf(instr.getArg1()).real;
+                if (!(real > -2147483649.0f && real < 2147483648.0f)) {
+                    throw RuntimeError("float to int conversion out of range");
+                }
+                Constant value;
+                value.type = TypeId::INT;
+                value.integer = static_cast<int32_t>(real);
+                temps[slotOf(instr.getResult())] = value;
+                break;
+            }
+            case OpCode::MOVE:
+                temps[slotOf(instr.getResult())] = valueOf(instr.getArg1());
+                break;
+            
+            case OpCode::PHI: {
+                // The PHIs at the top of a block all read their arguments
+                // before any of them is written
+                size_t first = pc - 1;
+                size_t end = first;
+                incoming.clear();
+                for (; end < function.instructions.size() && function.instructions[end].opcode == OpCode::PHI; ++end) {
+                    const Instruction& phi = function.instructions[end];
+                    uint32_t begin = phi.getArg1().id;
+                    uint32_t a = begin;
+                    while (a < begin + phi.getArg2().id && function.phiArguments[a].label != previous) {
+                        ++a;
+                    }
+                    if (a == begin + phi.getArg2().id) {
+                        throw RuntimeError("PHI has no argument for label " + std::to_string(previous));
+                    }
+                    incoming.push_back(valueOf(function.phiArguments[a].value));
+                }
+                for (size_t i = first; i < end; ++i) {
+                    temps[slotOf(function.instructions[i].getResult())] = incoming[i - first];
+                }
+                pc = end;
+                break;
+            }
+        }
+    }
+    --depth;
+    Constant result;
+    result.type = TypeId::VOID;
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+// interpreter.h
+#pragma once
+#include "ir.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+// Raised when the program traps: division by zero, a call to a function
+// without a body, recursion or a loop that does not end
+class RuntimeError : public std::runtime_error {
+public:
+    explicit RuntimeError(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Executes an IRProgram directly, so that a program can be run before and
+// after optimization and the results compared. Runs every form the passes
+// leave behind: variables in LOAD and STORE, SSA temps joined by PHIs, and
+// temps placed in registers and spill slots.
+class Interpreter {
+private:
+    const IRProgram& program;
+    std::unordered_map<uint32_t, uint32_t> functionIndex;   // Function symbol to index
+    std::unordered_map<uint32_t, Constant> globals;
+    uint64_t steps = 0;
+    uint32_t depth = 0;
+    
+    Constant call(uint32_t function, const std::vector<Constant>& arguments);
+
+public:
+    explicit Interpreter(const IRProgram& program);
+    
+    // Runs the top-level code, then the function with the given symbol, and
+    // returns its result
+    Constant run(uint32_t entry);
+    // Instructions executed so far, not counting labels and PHIs
+    uint64_t getSteps() const { return steps; }
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+// ir.cpp
+#include "../include/ir.h"
+#include <algorithm>
+
+uint32_t ConstantPool::intern(const Constant& value) {
+    // The spelling is exact, so it identifies the value together with its type
+    std::string key = std::string(1, static_cast<char>(value.type)) + value.toString();
+    auto it = index.find(key);
+    if (it != index.end()) {
+        return it->second;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(constants.size());
+    constants.push_back(value);
+    index.emplace(std::move(key), id);
+    return id;
+}
+
+const char* opcodeName(OpCode op) {
+    switch (op) {
+        case OpCode::LOAD: return "LOAD";
+        case OpCode::STORE: return "STORE";
+        case OpCode::ADD: return "ADD";
+        case OpCode::SUB: return "SUB";
+        case OpCode::MUL: return "MUL";
+        case OpCode::DIV: return "DIV";
+        case OpCode::CMPEQ: return "CMPEQ";
+        case OpCode::CMPNE: return "CMPNE";
+        case OpCode::CMPLT: return "CMPLT";
+        case OpCode::CMPLE: return "CMPLE";
+        case OpCode::CMPGT: return "CMPGT";
+        case OpCode::CMPGE: return "CMPGE";
+        case OpCode::JMP: return "JMP";
+        case OpCode::JZ: return "JZ";
+        case OpCode::JNZ: return "JNZ";
+        case OpCode::PUSH: return "PUSH";
+        case OpCode::CALL: return "CALL";
+        case OpCode::RET: return "RET";
+        case OpCode::LABEL: return "LABEL";
+        case OpCode::ITOF: return "ITOF";
+        case OpCode::FTOI: return "FTOI";
+        case OpCode::MOVE: return "MOVE";
+        case OpCode::PHI: return "PHI";
+        default: return "UNKNOWN";
+    }
+}
+
+bool isBranch(OpCode op) {
+    return op == OpCode::JMP || op == OpCode::JZ || op == OpCode::JNZ;
+}
+
+void removeInstructions(IRFunction& function, const std::vector<bool>& removed) {
+    std::vector<Instruction>& instructions = function.instructions;
+    size_t kept = 0;
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (!removed[i]) {
+            instructions[kept++] = instructions[i];
+        }
+    }
+    instructions.erase(instructions.begin() + kept, instructions.end());
+}
+
+void removeRedundantJumps(IRFunction& function) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    std::vector<bool> removed(instructions.size(), false);
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        if (instructions[i].opcode != OpCode::JMP) {
+            continue;
+        }
+        
+        // PHI arguments name their predecessor by the label starting it, so
+        // in SSA form a jump may only fall through to the block it targets;
+        // skipping over other labels would enter the join from another block
+        size_t end = function.ssa ? std::min(i + 2, instructions.size()) : instructions.size();
+        for (size_t next = i + 1; next < end && instructions[next].opcode == OpCode::LABEL; ++next) {
+            if (instructions[next].getArg1() == instructions[i].getArg1()) {
+                removed[i] = true;
+                break;
+            }
+        }
+    }
+    removeInstructions(function, removed);
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+// ir.h
+#pragma once
+#include "types.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+enum class OpCode : uint8_t {
+    LOAD,       // result <- variable arg1
+    STORE,      // variable result <- arg1
+    ADD,        // result <- arg1 op arg2
+    SUB,
+    MUL,
+    DIV,
+    CMPEQ,      // result <- arg1 cond arg2, as a bool
+    CMPNE,
+    CMPLT,
+    CMPLE,
+    CMPGT,
+    CMPGE,
+    JMP,        // to label arg1
+    JZ,         // to label arg2 if arg1 is false or zero
+    JNZ,        // to label arg2 if arg1 is true or non-zero
+    PUSH,       // pass arg1 to the next call
+    CALL,       // result <- function arg1 with the last arg2 pushed values
+    RET,        // return arg1, if any
+    LABEL,      // label arg1
+    ITOF,       // result <- arg1 converted
+    FTOI,
+    MOVE,       // result <- arg1
+    PHI         // result <- value for the predecessor taken, from the function's
+                // phi arguments [arg1, arg1 + arg2)
+};
+
+// What an operand id refers to
+enum class OperandKind : uint8_t {
+    NONE,
+    TEMP,       // Virtual register, numbered per function
+    CONSTANT,   // Index into the program's ConstantPool
+    VARIABLE,   // Symbol index of a variable or parameter
+    LABEL,      // Label, numbered per function
+    FUNCTION,   // Symbol index of a function
+    IMMEDIATE   // Small unsigned integer held in the id itself
+};
+
+struct Operand {
+    OperandKind kind = OperandKind::NONE;
+    uint32_t id = 0;
+    
+    Operand() = default;
+    Operand(OperandKind kind, uint32_t id) : kind(kind), id(id) {}
+    
+    bool isNone() const { return kind == OperandKind::NONE; }
+    bool operator==(const Operand& other) const { return kind == other.kind && id == other.id; }
+    bool operator!=(const Operand& other) const { return !(*this == other); }
+};
+
+// A 16-byte instruction: opcode, operation type, the kinds of its three
+// operands packed in four bits each, and their 32-bit ids
+struct Instruction {
+    static constexpr int RESULT = 0;
+    static constexpr int ARG1 = 1;
+    static constexpr int ARG2 = 2;
+    
+    OpCode opcode;
+    TypeId type;
+    uint16_t kinds;
+    uint32_t ids[3];
+    
+    Instruction(OpCode op, TypeId t, Operand result = Operand(), Operand arg1 = Operand(), Operand arg2 = Operand())
+        : opcode(op), type(t), kinds(0), ids{0, 0, 0} {
+        setOperand(RESULT, result);
+        setOperand(ARG1, arg1);
+        setOperand(ARG2, arg2);
+    }
+    
+    Operand getOperand(int i) const {
+        return Operand(static_cast<OperandKind>((kinds >> (4 * i)) & 0xF), ids[i]);
+    }
+    void setOperand(int i, Operand operand) {
+        kinds = static_cast<uint16_t>((kinds & ~(0xF << (4 * i))) | (static_cast<unsigned>(operand.kind) << (4 * i)));
+        ids[i] = operand.id;
+    }
+    
+    Operand getResult() const { return getOperand(RESULT); }
+    Operand getArg1() const { return getOperand(ARG1); }
+    Operand getArg2() const { return getOperand(ARG2); }
+};
+
+static_assert(sizeof(Instruction) == 16, "Instructions are meant to stay 16 bytes");
+
+// Constants used by the program, each stored once
+class ConstantPool {
+private:
+    std::vector<Constant> constants;
+    std::unordered_map<std::string, uint32_t> index;
+
+public:
+    uint32_t intern(const Constant& value);
+    const Constant& get(uint32_t id) const { return constants[id]; }
+    size_t size() const { return constants.size(); }
+};
+
+// Incoming value of a PHI, by the label that starts the predecessor block
+struct PhiArgument {
+    uint32_t label;
+    Operand value;
+};
+
+// A parameter or local variable of a function
+struct IRVariable {
+    uint32_t symbol;
+    TypeId type;
+};
+
+// Where register allocation placed a temp
+enum class LocationKind : uint8_t {
+    NONE,       // Not allocated, or never live
+    REGISTER,   // Index into the register file
+    SPILL       // Index of a spill slot in the function's frame
+};
+
+struct Location {
+    LocationKind kind = LocationKind::NONE;
+    uint32_t index = 0;
+};
+
+// IR of one function. Temps and labels are numbered from 1 within it.
+struct IRFunction {
+    int symbol = -1;            // Function symbol, -1 for top-level initialization code
+    std::vector<Instruction> instructions;
+    uint32_t tempCount = 0;
+    uint32_t labelCount = 0;
+    std::vector<IRVariable> parameters;     // In declaration order
+    std::vector<IRVariable> locals;
+    // Hidden variable passes may keep the return value in, VOID for void
+    // functions; it is listed in locals once a pass uses it
+    IRVariable returnValue = {0, TypeId::VOID};
+    std::vector<PhiArgument> phiArguments;
+    bool ssa = false;           // Locals live in single-assignment temps joined by PHIs
+    std::vector<Location> locations;        // Per temp once registers are allocated, else empty
+    uint32_t spillSlots = 0;
+    
+    Operand newTemp() { return Operand(OperandKind::TEMP, ++tempCount); }
+    Operand newLabel() { return Operand(OperandKind::LABEL, ++labelCount); }
+};
+
+struct IRProgram {
+    ConstantPool constants;
+    std::vector<IRFunction> functions;   // Top-level code first, then functions in source order
+};
+
+// Operand helpers
+inline Operand tempOperand(uint32_t id) { return Operand(OperandKind::TEMP, id); }
+inline Operand constantOperand(uint32_t id) { return Operand(OperandKind::CONSTANT, id); }
+inline Operand variableOperand(uint32_t symbol) { return Operand(OperandKind::VARIABLE, symbol); }
+inline Operand functionOperand(uint32_t symbol) { return Operand(OperandKind::FUNCTION, symbol); }
+inline Operand immediateOperand(uint32_t value) { return Operand(OperandKind::IMMEDIATE, value); }
+
+const char* opcodeName(OpCode op);
+bool isBranch(OpCode op);
+
+// Removes the marked instructions in one pass, keeping the order of the rest
+void removeInstructions(IRFunction& function, const std::vector<bool>& removed);
+
+// Removes jumps to a label that directly follows them: the next instruction
+// in SSA form, or any label of the run after the jump otherwise
+void removeRedundantJumps(IRFunction& function);
\ No newline at end of file
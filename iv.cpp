@@ -0,0 +1,419 @@
+// iv.cpp
+#include "../include/iv.h"
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+
+// A header PHI stepped by an invariant amount each iteration
+struct BasicInduction {
+    uint32_t phi;          // Instruction of the PHI
+    Operand initial;       // Value from the preheader
+    uint32_t increment;    // Instruction computing the value for the latch
+    Operand step;
+    bool decreasing;       // Stepped by SUB rather than ADD
+};
+
+// A value basic * scale + offset computed in the loop
+struct DerivedInduction {
+    uint32_t instruction;
+    Operand basic;         // Result of the basic induction's PHI
+    Operand scale;
+    Operand offset;        // None for no offset
+};
+
+// State of strength reduction over one loop
+struct InductionRewriter {
+    IRFunction& function;
+    IRProgram& program;
+    const ControlFlowGraph& cfg;
+    const NaturalLoop& loop;
+    std::vector<bool> definedInLoop;                      // By temp
+    std::unordered_map<uint32_t, BasicInduction> basics;  // By temp of the PHI
+    std::vector<Instruction> preheaderCode;
+    std::vector<std::vector<Instruction>> insertedAfter;  // By instruction
+    std::vector<Instruction> headerPhis;
+    std::vector<Operand> renamed;                         // By temp
+    std::vector<bool> removed;
+    
+    InductionRewriter(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg, const NaturalLoop& loop);
+    
+    bool isInvariant(Operand operand) const;
+    bool constantOf(Operand operand, int32_t& value) const;
+    Operand emitArithmetic(OpCode op, Operand left, Operand right);
+    void findBasics();
+    bool reduce();
+    bool continuesWhile(uint32_t compare, const Instruction& test, bool mirrored, int64_t step) const;
+    void replaceExitTest(const BasicInduction& basic, const DerivedInduction& derived, Operand reduced);
+    void apply();
+};
+
+InductionRewriter::InductionRewriter(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg,
+                                     const NaturalLoop& loop)
+    : function(function), program(program), cfg(cfg), loop(loop), definedInLoop(function.tempCount + 1, false),
+      insertedAfter(function.instructions.size()), renamed(function.tempCount + 1),
+      removed(function.instructions.size(), false) {
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            Operand result = function.instructions[i].getResult();
+            if (result.kind == OperandKind::TEMP) {
+                definedInLoop[result.id] = true;
+            }
+        }
+    }
+}
+
+bool InductionRewriter::isInvariant(Operand operand) const {
+    return operand.kind == OperandKind::CONSTANT ||
+           (operand.kind == OperandKind::TEMP && !definedInLoop[operand.id]);
+}
+
+bool InductionRewriter::constantOf(Operand operand, int32_t& value) const {
+    if (operand.kind != OperandKind::CONSTANT || program.constants.get(operand.id).type != TypeId::INT) {
+        return false;
+    }
+    value = program.constants.get(operand.id).integer;
+    return true;
+}
+
+// Computes an integer operation in the preheader, folding constants
+Operand InductionRewriter::emitArithmetic(OpCode op, Operand left, Operand right) {
+    int32_t a;
+    int32_t b;
+    if (constantOf(left, a) && constantOf(right, b)) {
+        Constant value;
+        value.type = TypeId::INT;
+        value.integer = wrapInteger(op == OpCode::ADD ? int64_t(a) + b :
+                                    op == OpCode::SUB ? int64_t(a) - b : int64_t(a) * b);
+        return constantOperand(program.constants.intern(value));
+    }
+    
+    // Identities with 0 and 1 leave one side as it is
+    for (int side = 0; side < 2; ++side, std::swap(left, right)) {
+        int32_t value;
+        if (!constantOf(left, value) || (side == 0 && op == OpCode::SUB)) {
+            continue;
+        }
+        if ((op != OpCode::MUL && value == 0) || (op == OpCode::MUL && value == 1)) {
+            return right;
+        }
+        if (op == OpCode::MUL && value == 0) {
+            return left;
+        }
+    }
+    Operand result = function.newTemp();
+    preheaderCode.emplace_back(op, TypeId::INT, result, left, right);
+    return result;
+}
+
+void InductionRewriter::findBasics() {
+    const BasicBlock& header = cfg.getBlock(loop.header);
+    uint32_t preheaderLabel = cfg.getBlock(cfg.getPreheader(loop)).label;
+    uint32_t latchLabel = cfg.getBlock(loop.latches[0]).label;
+    
+    // Where each temp of the loop is defined
+    std::unordered_map<uint32_t, uint32_t> definitions;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            Operand result = function.instructions[i].getResult();
+            if (result.kind == OperandKind::TEMP) {
+                definitions.emplace(result.id, i);
+            }
+        }
+    }
+    
+    for (uint32_t i = header.first; i < header.last; ++i) {
+        const Instruction& phi = function.instructions[i];
+        if (phi.opcode != OpCode::PHI || phi.type != TypeId::INT || phi.getArg2().id != 2) {
+            continue;
+        }
+        Operand initial;
+        Operand next;
+        for (uint32_t a = phi.getArg1().id; a < phi.getArg1().id + 2; ++a) {
+            const PhiArgument& argument = function.phiArguments[a];
+            if (argument.label == preheaderLabel) {
+                initial = argument.value;
+            } else if (argument.label == latchLabel) {
+                next = argument.value;
+            }
+        }
+        if (initial.isNone() || next.kind != OperandKind::TEMP || !definitions.count(next.id)) {
+            continue;
+        }
+        
+        uint32_t increment = definitions[next.id];
+        const Instruction& instr = function.instructions[increment];
+        Operand self = phi.getResult();
+        Operand step;
+        if (instr.opcode == OpCode::ADD && instr.getArg1() == self) {
+            step = instr.getArg2();
+        } else if ((instr.opcode == OpCode::ADD || instr.opcode == OpCode::SUB) && instr.getArg2() == self) {
+            step = instr.opcode == OpCode::ADD ? instr.getArg1() : Operand();
+        } else if (instr.opcode == OpCode::SUB && instr.getArg1() == self) {
+            step = instr.getArg2();
+        }
+        if (!step.isNone() && isInvariant(step) && instr.type == TypeId::INT) {
+            basics.emplace(self.id, BasicInduction{i, initial, increment, step, instr.opcode == OpCode::SUB});
+        }
+    }
+}
+
+bool InductionRewriter::reduce() {
+    findBasics();
+    if (basics.empty()) {
+        return false;
+    }
+    
+    // Products of a basic induction variable, then sums with those products
+    std::unordered_map<uint32_t, DerivedInduction> products;
+    std::vector<DerivedInduction> derived;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = function.instructions[i];
+            if (instr.type != TypeId::INT || (instr.opcode != OpCode::MUL && instr.opcode != OpCode::ADD)) {
+                continue;
+            }
+            Operand left = instr.getArg1();
+            Operand right = instr.getArg2();
+            for (int side = 0; side < 2; ++side, std::swap(left, right)) {
+                if (instr.opcode == OpCode::MUL && left.kind == OperandKind::TEMP && basics.count(left.id) &&
+                    isInvariant(right)) {
+                    products.emplace(instr.getResult().id, DerivedInduction{i, left, right, Operand()});
+                    derived.push_back(products.at(instr.getResult().id));
+                    break;
+                }
+                if (instr.opcode == OpCode::ADD && left.kind == OperandKind::TEMP && products.count(left.id) &&
+                    isInvariant(right)) {
+                    const DerivedInduction& product = products.at(left.id);
+                    derived.push_back({i, product.basic, product.scale, right});
+                    break;
+                }
+            }
+        }
+    }
+    if (derived.empty()) {
+        return false;
+    }
+    
+    uint32_t preheaderLabel = cfg.getBlock(cfg.getPreheader(loop)).label;
+    uint32_t latchLabel = cfg.getBlock(loop.latches[0]).label;
+    for (const DerivedInduction& value : derived) {
+        const BasicInduction& basic = basics.at(value.basic.id);
+        Operand initial = emitArithmetic(OpCode::MUL, basic.initial, value.scale);
+        if (!value.offset.isNone()) {
+            initial = emitArithmetic(OpCode::ADD, initial, value.offset);
+        }
+        Operand step = emitArithmetic(OpCode::MUL, basic.step, value.scale);
+        
+        // The new variable advances right after the one it derives from
+        Operand reduced = function.newTemp();
+        Operand next = function.newTemp();
+        insertedAfter[basic.increment].emplace_back(basic.decreasing ? OpCode::SUB : OpCode::ADD, TypeId::INT,
+                                                    next, reduced, step);
+        uint32_t first = static_cast<uint32_t>(function.phiArguments.size());
+        function.phiArguments.push_back({preheaderLabel, initial});
+        function.phiArguments.push_back({latchLabel, next});
+        headerPhis.emplace_back(OpCode::PHI, TypeId::INT, reduced, immediateOperand(first), immediateOperand(2));
+        
+        Operand result = function.instructions[value.instruction].getResult();
+        renamed[result.id] = reduced;
+        removed[value.instruction] = true;
+        replaceExitTest(basic, value, reduced);
+    }
+    return true;
+}
+
+// Whether the loop exits at a branch on the comparison, which runs every
+// iteration, once i has passed the bound in the direction it steps
+bool InductionRewriter::continuesWhile(uint32_t compare, const Instruction& test, bool mirrored, int64_t step) const {
+    // The one use of the comparison is a conditional branch out of the loop
+    uint32_t exiting = UINT32_MAX;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = function.instructions[i];
+            if (i != compare && instr.opcode != OpCode::LABEL &&
+                (instr.getArg1() == test.getResult() || instr.getArg2() == test.getResult())) {
+                if (exiting != UINT32_MAX || (instr.opcode != OpCode::JZ && instr.opcode != OpCode::JNZ) ||
+                    i != bb.last - 1) {
+                    return false;
+                }
+                exiting = block;
+            }
+        }
+    }
+    for (uint32_t phi = 0; phi < function.phiArguments.size(); ++phi) {
+        if (function.phiArguments[phi].value == test.getResult()) {
+            return false;
+        }
+    }
+    if (exiting == UINT32_MAX || cfg.getBlock(exiting).successors.size() != 2 ||
+        !cfg.dominates(exiting, loop.latches[0])) {
+        return false;
+    }
+    
+    // Which way leaves the loop decides whether it goes on while the
+    // comparison holds or while it fails
+    const BasicBlock& bb = cfg.getBlock(exiting);
+    const Instruction& branch = function.instructions[bb.last - 1];
+    uint32_t target = cfg.blockOfLabel(branch.getArg2().id);
+    uint32_t fallThrough = bb.successors[0] == target ? bb.successors[1] : bb.successors[0];
+    bool targetInLoop = std::find(loop.blocks.begin(), loop.blocks.end(), target) != loop.blocks.end();
+    bool fallThroughInLoop = std::find(loop.blocks.begin(), loop.blocks.end(), fallThrough) != loop.blocks.end();
+    if (targetInLoop == fallThroughInLoop) {
+        return false;
+    }
+    bool takenWhenTrue = branch.opcode == OpCode::JNZ;
+    bool whileTrue = targetInLoop == takenWhenTrue;
+    
+    // Normalized to i op bound, going on while it holds
+    OpCode op = test.opcode;
+    if (mirrored) {
+        op = op == OpCode::CMPLT ? OpCode::CMPGT : op == OpCode::CMPGT ? OpCode::CMPLT :
+             op == OpCode::CMPLE ? OpCode::CMPGE : op == OpCode::CMPGE ? OpCode::CMPLE : op;
+    }
+    if (!whileTrue) {
+        op = op == OpCode::CMPLT ? OpCode::CMPGE : op == OpCode::CMPGE ? OpCode::CMPLT :
+             op == OpCode::CMPGT ? OpCode::CMPLE : op == OpCode::CMPLE ? OpCode::CMPGT : op;
+    }
+    return ((op == OpCode::CMPLT || op == OpCode::CMPLE) && step > 0) ||
+           ((op == OpCode::CMPGT || op == OpCode::CMPGE) && step < 0);
+}
+
+// Compares the derived variable in place of the basic one when the basic
+// one is used for nothing else and the comparison keeps its meaning
+void InductionRewriter::replaceExitTest(const BasicInduction& basic, const DerivedInduction& derived, Operand reduced) {
+    int32_t initial, step, scale, offset = 0;
+    if (!constantOf(basic.initial, initial) || !constantOf(basic.step, step) ||
+        !constantOf(derived.scale, scale) || scale <= 0 ||
+        (!derived.offset.isNone() && !constantOf(derived.offset, offset))) {
+        return;
+    }
+    
+    Operand self = function.instructions[basic.phi].getResult();
+    uint32_t compare = UINT32_MAX;
+    for (uint32_t i = 0; i < function.instructions.size(); ++i) {
+        const Instruction& instr = function.instructions[i];
+        bool uses = instr.opcode != OpCode::PHI && instr.opcode != OpCode::LABEL &&
+                    (instr.getArg1() == self || instr.getArg2() == self);
+        if (!uses || i == basic.increment || i == derived.instruction || removed[i]) {
+            continue;
+        }
+        bool isCompare = instr.opcode >= OpCode::CMPEQ && instr.opcode <= OpCode::CMPGE;
+        if (compare != UINT32_MAX || !isCompare || !definedInLoop[instr.getResult().id]) {
+            return;
+        }
+        compare = i;
+    }
+    for (const PhiArgument& argument : function.phiArguments) {
+        if (argument.value == self) {
+            return;
+        }
+    }
+    if (compare == UINT32_MAX) {
+        return;
+    }
+    
+    // The comparison has to decide, on every iteration, whether the loop
+    // goes on, and i has to step toward the bound it is tested against
+    Instruction& test = function.instructions[compare];
+    int boundSide = test.getArg1() == self ? Instruction::ARG2 : Instruction::ARG1;
+    int32_t bound;
+    if (!constantOf(test.getOperand(boundSide), bound) || test.getArg1() == test.getArg2() ||
+        !continuesWhile(compare, test, boundSide == Instruction::ARG1, step * (basic.decreasing ? -1 : 1))) {
+        return;
+    }
+    
+    // Every value i is tested with then lies between its start and one step
+    // past the bound; i and all the derived values have to stay in range
+    int64_t low = std::min<int64_t>(initial, bound) - std::abs(int64_t(step));
+    int64_t high = std::max<int64_t>(initial, bound) + std::abs(int64_t(step));
+    for (int64_t end : {low, high}) {
+        int64_t value = end * scale + offset;
+        if (end < INT32_MIN || end > INT32_MAX || value < INT32_MIN || value > INT32_MAX) {
+            return;
+        }
+    }
+    
+    Constant scaled;
+    scaled.type = TypeId::INT;
+    scaled.integer = static_cast<int32_t>(int64_t(bound) * scale + offset);
+    test.setOperand(boundSide, constantOperand(program.constants.intern(scaled)));
+    test.setOperand(boundSide == Instruction::ARG1 ? Instruction::ARG2 : Instruction::ARG1, reduced);
+}
+
+void InductionRewriter::apply() {
+    std::vector<Instruction>& instructions = function.instructions;
+    const BasicBlock& preheader = cfg.getBlock(cfg.getPreheader(loop));
+    uint32_t preheaderEnd = isBranch(instructions[preheader.last - 1].opcode) ? preheader.last - 1 : preheader.last;
+    const BasicBlock& header = cfg.getBlock(loop.header);
+    uint32_t headerBody = header.first + 1;
+    while (headerBody < header.last && instructions[headerBody].opcode == OpCode::PHI) {
+        ++headerBody;
+    }
+    
+    auto rename = [&](Operand operand) {
+        return operand.kind == OperandKind::TEMP && operand.id < renamed.size() && !renamed[operand.id].isNone()
+                   ? renamed[operand.id] : operand;
+    };
+    std::vector<Instruction> rewritten;
+    rewritten.reserve(instructions.size() + preheaderCode.size() + 2 * headerPhis.size());
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        if (i == preheaderEnd) {
+            rewritten.insert(rewritten.end(), preheaderCode.begin(), preheaderCode.end());
+        }
+        if (i == headerBody) {
+            rewritten.insert(rewritten.end(), headerPhis.begin(), headerPhis.end());
+        }
+        if (!removed[i]) {
+            Instruction instr = instructions[i];
+            if (instr.opcode != OpCode::PHI && instr.opcode != OpCode::LABEL) {
+                instr.setOperand(Instruction::ARG1, rename(instr.getArg1()));
+                instr.setOperand(Instruction::ARG2, rename(instr.getArg2()));
+            }
+            rewritten.push_back(instr);
+        }
+        rewritten.insert(rewritten.end(), insertedAfter[i].begin(), insertedAfter[i].end());
+    }
+    for (PhiArgument& argument : function.phiArguments) {
+        argument.value = rename(argument.value);
+    }
+    instructions = std::move(rewritten);
+}
+
+void InductionVariablePass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    // Each loop is visited once, by its header, after it is given a
+    // preheader; the graph is rebuilt after every change
+    std::unordered_set<uint32_t> visited;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        ControlFlowGraph cfg(function);
+        for (const NaturalLoop& loop : cfg.findNaturalLoops()) {
+            if (visited.count(cfg.getBlock(loop.header).label)) {
+                continue;
+            }
+            if (cfg.getPreheader(loop) == UINT32_MAX && insertPreheader(function, cfg, loop)) {
+                changed = true;
+                break;
+            }
+            visited.insert(cfg.getBlock(loop.header).label);
+            if (cfg.getPreheader(loop) == UINT32_MAX || loop.latches.size() != 1) {
+                continue;
+            }
+            InductionRewriter rewriter(function, program, cfg, loop);
+            if (rewriter.reduce()) {
+                rewriter.apply();
+                changed = true;
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+// iv.h
+#pragma once
+#include "optimizer.h"
+
+// Induction variable strength reduction on SSA form, for loops with a
+// preheader and one latch. A basic induction variable is an integer PHI in
+// the header whose value from the latch is the PHI plus or minus a loop
+// invariant step. A value i * k, or i * k + b, of a basic induction
+// variable i and invariants k and b becomes a PHI of its own, started in
+// the preheader and advanced by k times the step next to i's increment, so
+// the loop multiplies no more.
+//
+// When the only other use of i is the loop's exit test against a constant
+// bound, run every iteration with i stepping toward the bound, and i's
+// start, its step, k and b are constants that keep i * k + b in range for
+// every value tested, the test compares the derived variable against the
+// scaled bound instead and i is left dead.
+class InductionVariablePass : public FunctionPass {
+public:
+    const char* getName() const override { return "iv"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
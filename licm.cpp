@@ -0,0 +1,155 @@
+// licm.cpp
+#include "../include/licm.h"
+#include <unordered_set>
+
+// Pure instructions that cannot trap wherever they are moved
+static bool canHoist(const Instruction& instr, const IRProgram& program) {
+    switch (instr.opcode) {
+        case OpCode::LOAD:
+        case OpCode::MOVE:
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::CMPEQ:
+        case OpCode::CMPNE:
+        case OpCode::CMPLT:
+        case OpCode::CMPLE:
+        case OpCode::CMPGT:
+        case OpCode::CMPGE:
+        case OpCode::ITOF:
+            return true;
+        case OpCode::FTOI: {
+            // Out of range conversions trap; those in the loop's path are
+            // checked by the caller
+            Operand operand = instr.getArg1();
+            return operand.kind == OperandKind::CONSTANT &&
+                   convertConstant(program.constants.get(operand.id), TypeId::INT).isConstant();
+        }
+        case OpCode::DIV: {
+            // Integer division traps on a zero divisor and on INT32_MIN / -1
+            if (instr.type != TypeId::INT) {
+                return true;
+            }
+            Operand divisor = instr.getArg2();
+            if (divisor.kind != OperandKind::CONSTANT) {
+                return false;
+            }
+            const Constant& value = program.constants.get(divisor.id);
+            return value.type == TypeId::INT && value.integer != 0 && value.integer != -1;
+        }
+        default:
+            return false;
+    }
+}
+
+// Hoists the invariant instructions of one loop; returns whether any moved
+static bool hoistLoop(IRFunction& function, const IRProgram& program, const ControlFlowGraph& cfg,
+                      const NaturalLoop& loop) {
+    std::vector<Instruction>& instructions = function.instructions;
+    std::vector<bool> variant(function.tempCount + 1, false);   // Defined in the loop and not hoisted
+    std::unordered_set<uint32_t> storedVariables;
+    std::unordered_set<uint32_t> inLoop(loop.blocks.begin(), loop.blocks.end());
+    std::vector<uint32_t> exits;                                 // Blocks leaving the loop or returning
+    bool hasCall = false;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        bool leaves = instructions[bb.last - 1].opcode == OpCode::RET;
+        for (uint32_t successor : bb.successors) {
+            leaves = leaves || !inLoop.count(successor);
+        }
+        if (leaves) {
+            exits.push_back(block);
+        }
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = instructions[i];
+            if (instr.getResult().kind == OperandKind::TEMP) {
+                variant[instr.getResult().id] = true;
+            }
+            if (instr.opcode == OpCode::STORE) {
+                storedVariables.insert(instr.getResult().id);
+            }
+            hasCall = hasCall || instr.opcode == OpCode::CALL;
+        }
+    }
+    
+    // Blocks are in reverse postorder, so definitions come before their uses
+    std::vector<bool> hoisted(instructions.size(), false);
+    std::vector<Instruction> moved;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        
+        // A conversion that may trap only moves from a block every pass
+        // through the loop runs, so it cannot trap where it did not before
+        bool alwaysRuns = !exits.empty();
+        for (uint32_t exit : exits) {
+            alwaysRuns = alwaysRuns && cfg.dominates(block, exit);
+        }
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = instructions[i];
+            if (!canHoist(instr, program) && !(instr.opcode == OpCode::FTOI && alwaysRuns)) {
+                continue;
+            }
+            bool invariant = true;
+            for (Operand operand : {instr.getArg1(), instr.getArg2()}) {
+                invariant = invariant && !(operand.kind == OperandKind::TEMP && variant[operand.id]);
+            }
+            if (instr.opcode == OpCode::LOAD) {
+                invariant = invariant && !hasCall && !storedVariables.count(instr.getArg1().id);
+            }
+            if (invariant) {
+                hoisted[i] = true;
+                moved.push_back(instr);
+                variant[instr.getResult().id] = false;
+            }
+        }
+    }
+    if (moved.empty()) {
+        return false;
+    }
+    
+    // Hoisted code runs at the end of the preheader, before its jump
+    const BasicBlock& preheader = cfg.getBlock(cfg.getPreheader(loop));
+    uint32_t insertAt = isBranch(instructions[preheader.last - 1].opcode) ? preheader.last - 1 : preheader.last;
+    
+    std::vector<Instruction> rewritten;
+    rewritten.reserve(instructions.size());
+    for (uint32_t i = 0; i <= instructions.size(); ++i) {
+        if (i == insertAt) {
+            rewritten.insert(rewritten.end(), moved.begin(), moved.end());
+        }
+        if (i < instructions.size() && !hoisted[i]) {
+            rewritten.push_back(instructions[i]);
+        }
+    }
+    instructions = std::move(rewritten);
+    return true;
+}
+
+void LoopInvariantCodeMotionPass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    // Each loop is visited once, by its header, after it is given a
+    // preheader; the graph is rebuilt after every change
+    std::unordered_set<uint32_t> visited;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        ControlFlowGraph cfg(function);
+        for (const NaturalLoop& loop : cfg.findNaturalLoops()) {
+            if (visited.count(cfg.getBlock(loop.header).label)) {
+                continue;
+            }
+            if (cfg.getPreheader(loop) == UINT32_MAX && insertPreheader(function, cfg, loop)) {
+                changed = true;
+                break;
+            }
+            visited.insert(cfg.getBlock(loop.header).label);
+            if (cfg.getPreheader(loop) != UINT32_MAX && hoistLoop(function, program, cfg, loop)) {
+                changed = true;
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file
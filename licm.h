@@ -0,0 +1,19 @@
+// licm.h
+#pragma once
+#include "optimizer.h"
+
+// Loop-invariant code motion on SSA form. Natural loops are visited inner
+// loops first. An instruction in a loop is invariant when it has no side
+// effects, cannot trap, and each operand is a constant or a value defined
+// outside the loop or by another invariant instruction. A float to int
+// conversion, which traps out of range, also qualifies when its operand is
+// a constant in range or its block dominates every exit. A load of a global
+// is invariant only if the loop neither stores to it nor calls. Invariant
+// instructions move to the end of the loop's preheader, inserted first if
+// the loop has none, so what an inner loop hoists can leave the outer loop
+// too.
+class LoopInvariantCodeMotionPass : public FunctionPass {
+public:
+    const char* getName() const override { return "licm"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
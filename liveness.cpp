@@ -0,0 +1,77 @@
+// liveness.cpp
+#include "../include/liveness.h"
+#include "../include/dataflow.h"
+
+Liveness::Liveness(const IRFunction& function, const ControlFlowGraph& cfg)
+    : function(function), cfg(cfg), itemCount(function.tempCount + 1) {
+    for (const auto* variables : {&function.parameters, &function.locals}) {
+        for (const IRVariable& variable : *variables) {
+            localItems.emplace(variable.symbol, itemCount++);
+        }
+    }
+    solve();
+}
+
+int Liveness::itemOf(Operand operand) const {
+    if (operand.kind == OperandKind::TEMP) {
+        return static_cast<int>(operand.id);
+    }
+    if (operand.kind == OperandKind::VARIABLE) {
+        auto it = localItems.find(operand.id);
+        return it == localItems.end() ? -1 : static_cast<int>(it->second);
+    }
+    return -1;
+}
+
+int Liveness::definedItem(const Instruction& instr) const {
+    if (instr.opcode == OpCode::STORE || instr.getResult().kind == OperandKind::TEMP) {
+        return itemOf(instr.getResult());
+    }
+    return -1;
+}
+
+// live-in = uses + (live-out - defs), with the union as meet
+class LivenessProblem : public DataflowProblem<BitSet> {
+private:
+    uint32_t itemCount;
+    std::vector<BitSet> uses;   // Upward-exposed uses of each block
+    std::vector<BitSet> defs;
+
+public:
+    LivenessProblem(const Liveness& liveness, const IRFunction& function, const ControlFlowGraph& cfg)
+        : itemCount(liveness.size()), uses(cfg.size(), BitSet(itemCount)), defs(cfg.size(), BitSet(itemCount)) {
+        for (uint32_t b = 0; b < cfg.size(); ++b) {
+            const BasicBlock& bb = cfg.getBlock(b);
+            for (uint32_t i = bb.first; i < bb.last; ++i) {
+                const Instruction& instr = function.instructions[i];
+                liveness.forEachUse(instr, [&](uint32_t item) {
+                    if (!defs[b].test(item)) {
+                        uses[b].set(item);
+                    }
+                });
+                int defined = liveness.definedItem(instr);
+                if (defined >= 0) {
+                    defs[b].set(defined);
+                }
+            }
+        }
+    }
+    
+    DataflowDirection direction() const override { return DataflowDirection::BACKWARD; }
+    BitSet boundary() const override { return BitSet(itemCount); }
+    BitSet top() const override { return BitSet(itemCount); }
+    void meet(BitSet& into, const BitSet& from) const override { into.unionWith(from); }
+    
+    BitSet transfer(uint32_t block, const BitSet& liveOut) const override {
+        BitSet liveIn = liveOut;
+        liveIn.subtract(defs[block]);
+        liveIn.unionWith(uses[block]);
+        return liveIn;
+    }
+};
+
+void Liveness::solve() {
+    DataflowResult<BitSet> result = solveDataflow(cfg, LivenessProblem(*this, function, cfg));
+    liveIn = std::move(result.in);
+    liveOut = std::move(result.out);
+}
\ No newline at end of file
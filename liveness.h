@@ -0,0 +1,51 @@
+// liveness.h
+#pragma once
+#include "cfg.h"
+#include "bitset.h"
+#include <unordered_map>
+#include <vector>
+
+// Live variable analysis for a function outside SSA form, solved backward
+// over bitsets. Items are the function's temps, numbered by temp id,
+// followed by its parameters and locals; globals are not tracked since
+// other functions can read them.
+class Liveness {
+private:
+    const IRFunction& function;
+    const ControlFlowGraph& cfg;
+    std::unordered_map<uint32_t, uint32_t> localItems;   // Variable symbol to item
+    uint32_t itemCount;
+    std::vector<BitSet> liveIn;
+    std::vector<BitSet> liveOut;
+    
+    void solve();
+
+public:
+    Liveness(const IRFunction& function, const ControlFlowGraph& cfg);
+    
+    uint32_t size() const { return itemCount; }
+    
+    // Item of a temp or local variable operand, -1 for anything else
+    int itemOf(Operand operand) const;
+    // Item an instruction writes, -1 if none
+    int definedItem(const Instruction& instr) const;
+    // Calls visit with each item an instruction reads
+    template <typename Visit>
+    void forEachUse(const Instruction& instr, Visit&& visit) const;
+    
+    const BitSet& getLiveIn(uint32_t block) const { return liveIn[block]; }
+    const BitSet& getLiveOut(uint32_t block) const { return liveOut[block]; }
+};
+
+template <typename Visit>
+void Liveness::forEachUse(const Instruction& instr, Visit&& visit) const {
+    if (instr.opcode == OpCode::LABEL) {
+        return;
+    }
+    for (Operand operand : {instr.getArg1(), instr.getArg2()}) {
+        int item = itemOf(operand);
+        if (item >= 0) {
+            visit(static_cast<uint32_t>(item));
+        }
+    }
+}
\ No newline at end of file
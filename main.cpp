@@ -1,78 +1,138 @@
-#include "../include/lexer.h"
-#include "../include/parser.h"
-#include "../include/symboltable.h"
-#include "../include/typechecker.h"
-#include "../include/codegen.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <stdexcept>
-#include <vector>
-
-std::string readFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
-        throw std::runtime_error("Could not open file: " + filename);
-    }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <source_file>" << std::endl;
-        return 1;
-    }
-
-    try {
-        // Read source file
-        std::string source = readFile(argv[1]);
-
-        // Initialize compiler components
-        Lexer lexer(source);
-        Parser parser(lexer);
-        TypeChecker typeChecker;
-        CodeGenerator codeGen;
-
-        // Parse the source code
-        std::cout << "Parsing source code..." << std::endl;
-        auto ast = parser.parse();
-
-        // Perform semantic analysis
-        std::cout << "Performing semantic analysis..." << std::endl;
-        bool hasErrors = false;
-        try {
-            typeChecker.check(ast);
-            std::cout << "No semantic errors found." << std::endl;
-        } catch (const TypeError& e) {
-            std::cerr << "Type error: " << e.what() << std::endl;
-            hasErrors = true;
-        }
-
-        // If there are no errors, generate code
-        if (!hasErrors) {
-            // Generate code
-            std::cout << "Generating code..." << std::endl;
-            codeGen.generate(ast);
-
-            // Optimize the generated code
-            std::cout << "Optimizing..." << std::endl;
-            codeGen.optimize();
-
-            // Output the generated code
-            std::cout << "\nGenerated Code:" << std::endl;
-            std::cout << "----------------" << std::endl;
-            codeGen.dumpCode();
-        } else {
-            std::cerr << "Compilation stopped due to semantic errors." << std::endl;
-            return 1;
-        }
-
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
-    }
-
-    return 0;
-} 
\ No newline at end of file
+#include "../include/lexer.h"
+#include "../include/parser.h"
+#include "../include/symboltable.h"
+#include "../include/binder.h"
+#include "../include/typechecker.h"
+#include "../include/folder.h"
+#include "../include/codegen.h"
+#include "../include/optimizer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+// How often watch mode polls the source file
+constexpr int WATCH_INTERVAL_MS = 500;
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Runs the whole pipeline on one source text and returns the exit code. A
+// cache carries type checking results over from the previous run.
+int compile(const std::string& source, CheckCache* cache) {
+    try {
+        // Initialize compiler components
+        Lexer lexer(source);
+        Parser parser(lexer);
+        Binder binder;
+        TypeChecker typeChecker(binder);
+        ConstantFolder folder(binder, typeChecker);
+        CodeGenerator codeGen(binder, typeChecker, folder);
+        typeChecker.setCache(cache);
+
+        // Parse the source code
+        std::cout << "Parsing source code..." << std::endl;
+        auto ast = parser.parse();
+
+        // Resolve names to symbols and frame slots
+        std::cout << "Binding names..." << std::endl;
+        binder.bind(ast);
+
+        // Perform semantic analysis
+        std::cout << "Performing semantic analysis..." << std::endl;
+        bool hasErrors = false;
+        try {
+            typeChecker.check(ast);
+            std::cout << "No semantic errors found." << std::endl;
+        } catch (const TypeError& e) {
+            std::cerr << "Type error: " << e.what() << std::endl;
+            hasErrors = true;
+        }
+        if (cache) {
+            std::cout << "Checked " << cache->getCheckedCount() << " functions, reused "
+                      << cache->getReusedCount() << "." << std::endl;
+        }
+
+        // If there are no errors, generate code
+        if (!hasErrors) {
+            // Fold constant expressions
+            std::cout << "Folding constants..." << std::endl;
+            folder.fold(ast);
+
+            // Generate code
+            std::cout << "Generating code..." << std::endl;
+            codeGen.generate(ast);
+
+            // Optimize the generated code
+            std::cout << "Optimizing..." << std::endl;
+            PassManager passManager;
+            passManager.addDefaultPipeline();
+            passManager.run(codeGen.getProgram());
+            passManager.report(std::cout);
+
+            // Output the generated code
+            std::cout << "\nGenerated Code:" << std::endl;
+            std::cout << "----------------" << std::endl;
+            codeGen.dumpCode();
+        } else {
+            std::cerr << "Compilation stopped due to semantic errors." << std::endl;
+            return 1;
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+// Recompiles the file whenever it changes, only re-checking functions that
+// were edited or whose callees changed signature
+int watch(const std::string& filename) {
+    CheckCache cache;
+    std::filesystem::file_time_type lastWrite;
+
+    while (true) {
+        std::error_code error;
+        auto writeTime = std::filesystem::last_write_time(filename, error);
+        if (!error && writeTime != lastWrite) {
+            lastWrite = writeTime;
+            try {
+                compile(readFile(filename), &cache);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+            std::cout << "\nWatching " << filename << " for changes..." << std::endl;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_INTERVAL_MS));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--watch") {
+        return watch(argv[2]);
+    }
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--watch] <source_file>" << std::endl;
+        return 1;
+    }
+
+    try {
+        return compile(readFile(argv[1]), nullptr);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file
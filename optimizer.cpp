@@ -0,0 +1,141 @@
+// optimizer.cpp
+#include "../include/optimizer.h"
+#include "../include/ssa.h"
+#include "../include/sccp.h"
+#include "../include/gvn.h"
+#include "../include/dce.h"
+#include "../include/copyprop.h"
+#include "../include/regalloc.h"
+#include "../include/licm.h"
+#include "../include/iv.h"
+#include "../include/unroll.h"
+#include "../include/inliner.h"
+#include "../include/tailcall.h"
+#include <chrono>
+#include <iomanip>
+
+// Passes run by default, in order
+static const char* const DEFAULT_PIPELINE[] = {
+    "inline",
+    "tail-call",
+    "unreachable-blocks",
+    "redundant-store",
+    "unroll",
+    "ssa",
+    "sccp",
+    "copy-prop",
+    "gvn",
+    "licm",
+    "iv",
+    "dce",
+    "out-of-ssa",
+    "coalesce",
+    "dce",
+    "regalloc"
+};
+
+static size_t instructionCount(const IRProgram& program) {
+    size_t count = 0;
+    for (const auto& function : program.functions) {
+        count += function.instructions.size();
+    }
+    return count;
+}
+
+void FunctionPass::run(IRProgram& program) {
+    for (auto& function : program.functions) {
+        runOnFunction(function, program);
+    }
+}
+
+void RedundantStorePass::runOnFunction(IRFunction& function, IRProgram&) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    std::vector<bool> removed(instructions.size(), false);
+    
+    for (size_t i = 1; i < instructions.size(); ++i) {
+        const Instruction& load = instructions[i - 1];
+        const Instruction& store = instructions[i];
+        if (load.opcode == OpCode::LOAD && store.opcode == OpCode::STORE &&
+            store.getArg1() == load.getResult() && store.getResult() == load.getArg1()) {
+            removed[i] = true;
+        }
+    }
+    
+    removeInstructions(function, removed);
+}
+
+void UnreachableBlockPass::runOnFunction(IRFunction& function, IRProgram&) {
+    removeUnreachableBlocks(function);
+}
+
+void PassManager::addPass(std::unique_ptr<Pass> pass) {
+    passes.push_back(std::move(pass));
+}
+
+bool PassManager::addPass(std::string_view name) {
+    // Passes by the name they report
+    if (name == "inline") {
+        addPass(std::make_unique<InliningPass>());
+    } else if (name == "tail-call") {
+        addPass(std::make_unique<TailCallPass>());
+    } else if (name == "unreachable-blocks") {
+        addPass(std::make_unique<UnreachableBlockPass>());
+    } else if (name == "redundant-store") {
+        addPass(std::make_unique<RedundantStorePass>());
+    } else if (name == "unroll") {
+        addPass(std::make_unique<LoopUnrollPass>());
+    } else if (name == "ssa") {
+        addPass(std::make_unique<SSAConstructionPass>());
+    } else if (name == "sccp") {
+        addPass(std::make_unique<SCCPPass>());
+    } else if (name == "copy-prop") {
+        addPass(std::make_unique<CopyPropagationPass>());
+    } else if (name == "gvn") {
+        addPass(std::make_unique<GVNPass>());
+    } else if (name == "licm") {
+        addPass(std::make_unique<LoopInvariantCodeMotionPass>());
+    } else if (name == "iv") {
+        addPass(std::make_unique<InductionVariablePass>());
+    } else if (name == "dce") {
+        addPass(std::make_unique<DeadCodePass>());
+    } else if (name == "out-of-ssa") {
+        addPass(std::make_unique<SSADestructionPass>());
+    } else if (name == "coalesce") {
+        addPass(std::make_unique<CoalescingPass>());
+    } else if (name == "regalloc") {
+        addPass(std::make_unique<RegisterAllocationPass>());
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void PassManager::addDefaultPipeline() {
+    for (const char* name : DEFAULT_PIPELINE) {
+        addPass(name);
+    }
+}
+
+void PassManager::run(IRProgram& program) {
+    timings.clear();
+    for (const auto& pass : passes) {
+        size_t before = instructionCount(program);
+        auto start = std::chrono::steady_clock::now();
+        pass->run(program);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        timings.push_back({pass->getName(), elapsed.count(), before, instructionCount(program)});
+    }
+}
+
+void PassManager::report(std::ostream& out) const {
+    double total = 0.0;
+    for (const auto& timing : timings) {
+        out << "  " << std::left << std::setw(20) << timing.name << std::right
+            << std::fixed << std::setprecision(3) << std::setw(10) << timing.milliseconds << " ms  "
+            << timing.instructionsBefore << " -> " << timing.instructionsAfter << " instructions" << std::endl;
+        total += timing.milliseconds;
+    }
+    out << "  " << std::left << std::setw(20) << "total" << std::right
+        << std::fixed << std::setprecision(3) << std::setw(10) << total << " ms" << std::endl;
+    out.unsetf(std::ios::floatfield | std::ios::adjustfield);
+}
\ No newline at end of file
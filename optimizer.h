@@ -0,0 +1,65 @@
+// optimizer.h
+#pragma once
+#include "ir.h"
+#include "cfg.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+// An optimization pass over the whole program. Passes rewrite the IR in time
+// linear in its size: they mark instructions and compact once, or build a
+// new instruction list, rather than erasing in place.
+class Pass {
+public:
+    virtual ~Pass() = default;
+    virtual const char* getName() const = 0;
+    virtual void run(IRProgram& program) = 0;
+};
+
+// A pass that transforms each function independently
+class FunctionPass : public Pass {
+public:
+    void run(IRProgram& program) override;
+    virtual void runOnFunction(IRFunction& function, IRProgram& program) = 0;
+};
+
+// Drops a STORE of the value just loaded from the same variable
+class RedundantStorePass : public FunctionPass {
+public:
+    const char* getName() const override { return "redundant-store"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
+
+// Removes blocks that cannot be reached from the function entry
+class UnreachableBlockPass : public FunctionPass {
+public:
+    const char* getName() const override { return "unreachable-blocks"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
+
+// Time and size effect of one pass run
+struct PassTiming {
+    const char* name;
+    double milliseconds;
+    size_t instructionsBefore;
+    size_t instructionsAfter;
+};
+
+// Runs an ordered pipeline of passes and records how long each one took
+class PassManager {
+private:
+    std::vector<std::unique_ptr<Pass>> passes;
+    std::vector<PassTiming> timings;
+
+public:
+    void addPass(std::unique_ptr<Pass> pass);
+    bool addPass(std::string_view name);
+    void addDefaultPipeline();
+    
+    void run(IRProgram& program);
+    void report(std::ostream& out) const;
+    const std::vector<std::unique_ptr<Pass>>& getPasses() const { return passes; }
+    const std::vector<PassTiming>& getTimings() const { return timings; }
+};
\ No newline at end of file
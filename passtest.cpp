@@ -0,0 +1,927 @@
+// passtest.cpp
+// Runs sample programs in the interpreter, unoptimized and after each pass of
+// the default pipeline, and checks that every run returns what the source
+// program computes. A failure names the first pass that changed the result.
+// Edits of a program are type checked with the watch-mode cache primed by
+// the previous version, and must give what a clean check gives.
+#include "../include/lexer.h"
+#include "../include/parser.h"
+#include "../include/binder.h"
+#include "../include/typechecker.h"
+#include "../include/folder.h"
+#include "../include/codegen.h"
+#include "../include/optimizer.h"
+#include "../include/interpreter.h"
+#include <iostream>
+#include <string>
+#include <exception>
+#include <iterator>
+
+struct Sample {
+    const char* name;
+    int32_t expected;       // Value main returns
+    const char* source;
+};
+
+// A change made in watch mode to code outside the function it affects
+struct Edit {
+    const char* name;
+    const char* before;
+    const char* after;
+};
+
+static const Sample SAMPLES[] = {
+    {"empty-else", 7, R"(
+int g = 1;
+int main() {
+    int x = 5;
+    if (g > 0) {
+        x = 7;
+    } else {
+    }
+    return x;
+}
+)"},
+    {"spills", -1708828754, R"(
+int mix(int p, int q) {
+    int a0 = p * 3 + q;
+    int a1 = a0 * 3 - p + 1;
+    int a2 = a1 * 4 - p + 2;
+    int a3 = a2 * 5 - p + 3;
+    int a4 = a3 * 6 - p + 4;
+    int a5 = a4 * 2 - p + 5;
+    int a6 = a5 * 3 - p + 6;
+    int a7 = a6 * 4 - p + 7;
+    int a8 = a7 * 5 - p + 8;
+    int a9 = a8 * 6 - p + 9;
+    int a10 = a9 * 2 - p + 10;
+    int a11 = a10 * 3 - p + 11;
+    int a12 = a11 * 4 - p + 12;
+    int a13 = a12 * 5 - p + 13;
+    int a14 = a13 * 6 - p + 14;
+    int a15 = a14 * 2 - p + 15;
+    int a16 = a15 * 3 - p + 16;
+    int a17 = a16 * 4 - p + 17;
+    int a18 = a17 * 5 - p + 18;
+    int a19 = a18 * 6 - p + 19;
+    int s = (a0 - a19) * 1 + (a1 - a18) * 2 + (a2 - a17) * 3 + (a3 - a16) * 4 + (a4 - a15) * 5;
+    s = s + (a5 - a14) * 6 + (a6 - a13) * 7 + (a7 - a12) * 8 + (a8 - a11) * 9 + (a9 - a10) * 10;
+    return s / 7 + p - q;
+}
+int main() {
+    return mix(2, 1) + mix(-3, 5) * 3 + mix(1, 0) * 7;
+}
+)"},
+    {"loops", 3314, R"(
+int g = 3;
+
+int square(int n) {
+    return n * n;
+}
+
+int sum(int n) {
+    int total = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        total = total + square(i);
+    }
+    return total;
+}
+
+int main() {
+    int x = 5;
+    float y = 2.5;
+    y = y * 2;
+    if (x >= 10) {
+        x = x + 1;
+    } else {
+        x = x - 1;
+    }
+    while (x < 20) {
+        x += 3;
+    }
+    bool b = x > 4;
+    int r = sum(x) + g;
+    return r;
+}
+)"},
+    {"self-assign", 1, R"(
+int main() {
+ int x = 1;
+ x = x;
+ return x;
+}
+)"},
+    {"dead-stores", 9, R"(
+int f(int n) {
+    int x = 5;
+    int unused = n * 3;
+    x = 6;
+    int i = 0;
+    int dead = 0;
+    while (i < n) {
+        dead = dead + i;
+        i = i + 1;
+    }
+    return x + i;
+}
+int main() {
+    return f(3);
+}
+)"},
+    {"constants", 46, R"(
+int f(int n) {
+    int x = 1;
+    int i = 0;
+    while (i < n) {
+        if (x != 1) {
+            x = 2;
+        }
+        i = i + 1;
+    }
+    int y = x * 10;
+    if (y > 5) {
+        return y + i;
+    }
+    return 0;
+}
+int main() {
+    int a = 7;
+    int b = a * 3 + 1;
+    float c = b / 2;
+    int d = 10 / (a - 7 + 1);
+    return f(4) + b + d;
+}
+)"},
+    {"negative-zero", 1, R"(
+float zero = 0.0;
+int main() {
+    float negated = -zero;
+    if (1.0 / negated < 0.0) {
+        return 1;
+    }
+    return 0;
+}
+)"},
+    {"value-numbering", 71045, R"(
+int g = 1;
+int bump() {
+    g = g + 1;
+    return g;
+}
+int f(int x, int i) {
+    int a = x + i;
+    int b = i + x;
+    int c = g * 2;
+    int d = g * 2;
+    int e = bump();
+    int h = g * 2;
+    if (x > 0) {
+        g = 7;
+    }
+    int k = g + 0;
+    int m = g + 0;
+    g = a;
+    int n = g;
+    return a + b + c + d + e + h + k + m + n;
+}
+int main() {
+    return f(3, 4) + f(-1, 2) * 1000;
+}
+)"},
+    {"copies", 14008256, R"(
+int f(int a, int b) {
+    int n = 0;
+    while (n < 7) {
+        int t = a;
+        a = b;
+        b = t;
+        n = n + 1;
+    }
+    return a * 100 + b;
+}
+int g(int x) {
+    int y = 0;
+    if (x > 1) {
+        y = 5;
+    }
+    return y + x;
+}
+int h(int x) {
+    int r = 1;
+    while (x > 0) {
+        if (x > 3) {
+            r = r * 2;
+        } else {
+            r = r + x;
+        }
+        x = x - 1;
+    }
+    return r;
+}
+int lost(int n) {
+    int a = 0;
+    int b = 1;
+    int i = 0;
+    while (i < n) {
+        int c = a + b;
+        a = b;
+        b = c;
+        i = i + 1;
+    }
+    return a;
+}
+int main() {
+    return f(1, 2) + g(3) * 1000 + g(0) * 100000 + h(6) * 1000000 + lost(10);
+}
+)"},
+    {"invariants", 955, R"(
+int g = 3;
+int h = 5;
+int inv(int n, int a, int b) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        int k = a * b + g;
+        int d = a / 7;
+        s = s + k + d;
+        i = i + 1;
+    }
+    return s;
+}
+int nested(int n, int a) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        for (int j = 0; j < n; j = j + 1) {
+            s = s + a * 3 + i * 2 + h;
+        }
+        h = h + 1;
+    }
+    return s;
+}
+int dowhile(int n, int x) {
+    int s = 0;
+    int i = 0;
+    while (true) {
+        s = s + x * x;
+        i = i + 1;
+        if (i >= n) {
+            return s;
+        }
+    }
+    return 0;
+}
+int entry(int n, int c) {
+    int s = 0;
+    int i = 0;
+    if (c > 0) {
+        i = 1;
+    }
+    while (i < n) {
+        s = s + c * 4;
+        i = i + 1;
+    }
+    return s;
+}
+int divz(int n, int z) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        s = s + 100 / z;
+        i = i + 1;
+    }
+    return s;
+}
+int main() {
+    return inv(10, 3, 4) + nested(4, 2) * 3 + dowhile(5, 3) + entry(6, 2) + entry(6, -1) + divz(0, 0);
+}
+)"},
+    {"guarded-conversion", 14, R"(
+float g = 100000000000.0;
+float h = 2.5;
+int count = 4;
+int guarded(int n) {
+    int s = 0;
+    int i = 0;
+    while (i < n) {
+        if (g < 100.0) {
+            int k = g;
+            s = s + k;
+        }
+        int m = h;
+        s = s + m + i;
+        i = i + 1;
+    }
+    return s;
+}
+int main() {
+    return guarded(count);
+}
+)"},
+    {"conversion-range", 13, R"(
+int count = 4;
+int main() {
+    int k = 7;
+    for (int i = 0; i < count; i = i + 1) {
+        if (i > 10) {
+            int big = 100000000000.0;
+            k = big;
+        }
+        k = k + i;
+    }
+    return k;
+}
+)"},
+    {"induction", 1704128054, R"(
+int g = 0;
+int lin(int n, int k) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        s = s + i * k;
+    }
+    return s;
+}
+int lftr() {
+    int s = 0;
+    for (int i = 0; i < 10; i = i + 1) {
+        s = s + (i * 4 + 100);
+    }
+    return s;
+}
+int down() {
+    int s = 0;
+    int i = 20;
+    while (i > 2) {
+        s = s + 3 * i;
+        i = i - 2;
+    }
+    return s;
+}
+int mirrored() {
+    int s = 0;
+    int i = 0;
+    while (50 > i) {
+        s = s + i * 7;
+        i = i + 5;
+    }
+    return s;
+}
+int usedafter(int n) {
+    int i = 0;
+    int t = 0;
+    while (i < 8) {
+        t = i * 3;
+        i = i + 1;
+    }
+    return t + i;
+}
+int wrap() {
+    int s = 0;
+    int i = 0;
+    while (i < 1000000000) {
+        s = s + i * 1000;
+        i = i + 400000000;
+    }
+    return s;
+}
+int dowhile(int x) {
+    int s = 0;
+    int i = 0;
+    while (true) {
+        s = s + i * x;
+        i = i + 1;
+        if (i >= 6) {
+            return s;
+        }
+    }
+    return 0;
+}
+int nested(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        for (int j = 0; j < n; j = j + 1) {
+            s = s + i * n + j * 2;
+        }
+    }
+    return s;
+}
+int main() {
+    return lin(10, 3) + lftr() + down() + mirrored() + usedafter(3) + wrap() + dowhile(3) + nested(5);
+}
+)"},
+    {"unrolling", 75691, R"(
+int g = 7;
+int full() {
+    int s = 0;
+    for (int i = 0; i < 10; i = i + 1) {
+        s = s * 3 + i;
+        if (s > 1000) {
+            s = s - 999;
+        }
+    }
+    return s;
+}
+int down() {
+    int s = 0;
+    for (int i = 20; i > 3; i = i - 3) {
+        s = s * 2 + i;
+    }
+    return s;
+}
+int bounded() {
+    int n = 6;
+    int s = 1;
+    int i = 0;
+    while (i <= n) {
+        s = s + i * i;
+        i = i + 1;
+    }
+    return s;
+}
+int partial(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        s = s * 5 + i;
+        s = s - (s / 1000) * 1000;
+    }
+    return s;
+}
+int partdown(int n, int m) {
+    int s = 0;
+    int i = n;
+    while (i >= m) {
+        s = s + i;
+        i = i - 2;
+    }
+    return s;
+}
+int early(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        if (s > 50) {
+            return s + i;
+        }
+        s = s + i * 3;
+    }
+    return s;
+}
+int nested(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        for (int j = 0; j < 4; j = j + 1) {
+            s = s + i * j + g;
+        }
+        g = g + 1;
+    }
+    return s;
+}
+int big() {
+    int s = 0;
+    for (int i = 0; i < 1000; i = i + 7) {
+        s = s + i;
+    }
+    return s;
+}
+int edge(int n) {
+    int s = 0;
+    int i = 2147483640;
+    while (i < n) {
+        s = s + 1;
+        i = i + 1;
+    }
+    return s;
+}
+int zero() {
+    int s = 5;
+    for (int i = 10; i < 3; i = i + 1) {
+        s = s + 1;
+    }
+    return s;
+}
+int main() {
+    return full() + down() + bounded() + partial(0) + partial(1) + partial(7) + partial(23) + partdown(17, 2) + partdown(3, 9) + early(100) + early(3) + nested(5) + big() + edge(2147483647) + zero();
+}
+)"},
+    {"inlining", 1287, R"(
+int g = 2;
+int sq(int x) {
+    return x * x;
+}
+int absval(int x) {
+    if (x < 0) {
+        return 0 - x;
+    }
+    return x;
+}
+void bump(int k) {
+    g = g + k;
+}
+int clamp(int x, int lo, int hi) {
+    if (x < lo) {
+        return lo;
+    }
+    if (x > hi) {
+        return hi;
+    }
+    return x;
+}
+int sumsq(int n) {
+    int s = 0;
+    for (int i = 0; i < n; i = i + 1) {
+        s = s + sq(i) + absval(i - 3);
+        bump(1);
+    }
+    return s;
+}
+int fact(int n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+int odd(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return even(n - 1);
+}
+int even(int n) {
+    if (n == 0) {
+        return 1;
+    }
+    return odd(n - 1);
+}
+int twice(int x) {
+    return sq(sq(x)) + clamp(x, 0, 10) + fact(3);
+}
+float half(float x) {
+    return x / 2.0;
+}
+int main() {
+    int a = sumsq(7);
+    int b = twice(3) + twice(-4);
+    int c = even(10) + odd(7) * 2;
+    float h = half(9.0);
+    int k = h * 10.0;
+    bump(g);
+    return a + b * 3 + c * 5 + g + clamp(a, 5, 50) + k;
+}
+)"},
+    {"inlined-locals", 5, R"(
+int g(int i) {
+    int x;
+    if (i == 0) {
+        x = 5;
+    }
+    return x;
+}
+int main() {
+    int s = 0;
+    for (int i = 0; i < 4; i = i + 1) {
+        s = s + g(i);
+    }
+    return s;
+}
+)"},
+    {"recursion", 5319136, R"(
+int g = 0;
+int factorial(int n) {
+    if (n <= 1) {
+        return 1;
+    }
+    return n * factorial(n - 1);
+}
+int sum(int n) {
+    if (n == 0) {
+        return 0;
+    }
+    return sum(n - 1) + n;
+}
+int sumacc(int n, int acc) {
+    if (n == 0) {
+        return acc;
+    }
+    return sumacc(n - 1, acc + n);
+}
+int gcd(int a, int b) {
+    if (b == 0) {
+        return a;
+    }
+    return gcd(b, a - (a / b) * b);
+}
+void countdown(int n) {
+    if (n > 0) {
+        g = g + n;
+        countdown(n - 1);
+    }
+}
+int fib(int n) {
+    if (n < 2) {
+        return n;
+    }
+    return fib(n - 1) + fib(n - 2);
+}
+int mixed(int n) {
+    if (n <= 0) {
+        return 3;
+    }
+    if (n > 5) {
+        return mixed(n - 2) * 2;
+    }
+    return mixed(n - 1) + 1;
+}
+int power(int b, int e) {
+    if (e == 0) {
+        return 1;
+    }
+    return b * power(b, e - 1);
+}
+int main() {
+    countdown(100);
+    return factorial(10) + sum(300) + sumacc(300, 0) + gcd(1071, 462) + g + fib(15) + mixed(9) + power(3, 13);
+}
+)"},
+    {"recursion-locals", 100, R"(
+int start = 3;
+int f(int n) {
+    int x;
+    if (n == 3) {
+        x = 100;
+    }
+    if (n == 0) {
+        return 0;
+    }
+    return f(n - 1) + x;
+}
+int main() {
+    return f(start);
+}
+)"},
+    {"conditions", -970667, R"(
+int g = 0;
+bool top = g == 0 || g > 5;
+bool touch(int k) {
+    g = g + k;
+    return k > 2;
+}
+int guarded(int x, int y) {
+    if (x != 0 && y / x > 2) {
+        return 1;
+    }
+    if (!(x == 0) || y > 100) {
+        return 2;
+    }
+    return 3;
+}
+int counts(int n) {
+    int s = 0;
+    int i = 0;
+    while (i < n && !(s > 40)) {
+        s = s + i;
+        i++;
+    }
+    for (int j = 0; j < n || j < 3; j++) {
+        s = s + j;
+    }
+    return s * 100 + i;
+}
+int values(int a, int b) {
+    bool both = a > 0 && b > 0;
+    bool either = a > 0 || touch(b);
+    bool neither = !(a > 0) && !touch(a + b);
+    bool nested = (a > b || b > 10) && (touch(1) || a == b);
+    int r = 0;
+    if (both) {
+        r = r + 1;
+    }
+    if (either) {
+        r = r + 2;
+    }
+    if (neither) {
+        r = r + 4;
+    }
+    if (nested) {
+        r = r + 8;
+    }
+    if (both == either) {
+        r = r + 16;
+    }
+    return r;
+}
+int incs(int x) {
+    int a = x++;
+    int b = ++x;
+    int c = x--;
+    int d = --x;
+    float f = 1.5;
+    f++;
+    int e = -a + -(b * 2);
+    bool n = !x;
+    int r = a * 1000 + b * 100 + c * 10 + d + e * 7 + x;
+    if (n) {
+        r = r + 5;
+    }
+    if (!n && f > 2.0) {
+        r = r + 3;
+    }
+    return r;
+}
+int main() {
+    int r = guarded(0, 5) + guarded(2, 9) * 10 + guarded(3, 2) * 100 + guarded(0, 200) * 1000;
+    r = r + counts(5) + counts(20) + counts(0);
+    r = r + values(1, 1) + values(0, 3) * 3 + values(-1, -4) * 7 + values(5, 2) * 11 + values(0, 0) * 13;
+    r = r + incs(4) + incs(0) * 3 + incs(-1) * 5;
+    if (top) {
+        r = r + 1;
+    }
+    return r + g * 1000000;
+}
+)"},
+};
+
+static const Edit EDITS[] = {
+    {"global-over-local", R"(
+int f() {
+    int x = 1;
+    return x;
+}
+int main() {
+    return f();
+}
+)", R"(
+int x = 5;
+int f() {
+    int x = 1;
+    return x;
+}
+int main() {
+    return f();
+}
+)"},
+    {"global-over-parameter", R"(
+int f(int n) {
+    return n + 1;
+}
+int main() {
+    return f(2);
+}
+)", R"(
+float n = 1.5;
+int f(int n) {
+    return n + 1;
+}
+int main() {
+    return f(2);
+}
+)"},
+    {"global-type", R"(
+int y = 1;
+int f() {
+    return y * 2;
+}
+int main() {
+    return f();
+}
+)", R"(
+float y = 1.5;
+int f() {
+    return y * 2;
+}
+int main() {
+    return f();
+}
+)"},
+    {"callee-signature", R"(
+int g(int a) {
+    return a;
+}
+int f() {
+    return g(1);
+}
+int main() {
+    return f();
+}
+)", R"(
+int g(int a, int b) {
+    return a + b;
+}
+int f() {
+    return g(1);
+}
+int main() {
+    return f();
+}
+)"},
+};
+
+// Result of running a program, or the error that stopped it
+static std::string execute(const IRProgram& program, uint32_t entry) {
+    try {
+        return Interpreter(program).run(entry).toString();
+    } catch (const std::exception& e) {
+        return std::string("error: ") + e.what();
+    }
+}
+
+// Checks one sample and returns whether it passed
+static bool check(const Sample& sample) {
+    Lexer lexer(sample.source);
+    Parser parser(lexer);
+    Binder binder;
+    TypeChecker typeChecker(binder);
+    ConstantFolder folder(binder, typeChecker);
+    CodeGenerator codeGen(binder, typeChecker, folder);
+    auto ast = parser.parse();
+    binder.bind(ast);
+    typeChecker.check(ast);
+    folder.fold(ast);
+    codeGen.generate(ast);
+    uint32_t entry = binder.resolveGlobal("main").symbol;
+    
+    Constant value;
+    value.type = TypeId::INT;
+    value.integer = sample.expected;
+    std::string expected = value.toString();
+    std::string unoptimized = execute(codeGen.getProgram(), entry);
+    if (unoptimized != expected) {
+        std::cout << "FAIL " << sample.name << ": unoptimized returns " << unoptimized
+                  << ", expected " << expected << std::endl;
+        return false;
+    }
+    
+    PassManager passManager;
+    passManager.addDefaultPipeline();
+    for (const auto& pass : passManager.getPasses()) {
+        pass->run(codeGen.getProgram());
+        std::string optimized = execute(codeGen.getProgram(), entry);
+        if (optimized != expected) {
+            std::cout << "FAIL " << sample.name << ": after " << pass->getName() << " returns "
+                      << optimized << ", expected " << expected << std::endl;
+            return false;
+        }
+    }
+    std::cout << "PASS " << sample.name << std::endl;
+    return true;
+}
+
+// Errors and expression types of type checking a source, with or without
+// a cache
+static std::string typeCheck(const char* source, CheckCache* cache) {
+    Lexer lexer(source);
+    Parser parser(lexer);
+    Binder binder;
+    TypeChecker typeChecker(binder);
+    typeChecker.setCache(cache);
+    auto ast = parser.parse();
+    binder.bind(ast);
+    std::string result;
+    try {
+        typeChecker.check(ast);
+    } catch (const TypeError& e) {
+        result = e.what();
+    }
+    for (const ExpressionType& type : typeChecker.getExpressionTypes()) {
+        result += " " + std::to_string(type.type) + ":" + std::to_string(type.converted);
+    }
+    return result;
+}
+
+// Checks one edit and returns whether it passed
+static bool check(const Edit& edit) {
+    CheckCache cache;
+    typeCheck(edit.before, &cache);
+    std::string cached = typeCheck(edit.after, &cache);
+    std::string clean = typeCheck(edit.after, nullptr);
+    if (cached != clean) {
+        std::cout << "FAIL " << edit.name << ": cached check gives" << std::endl << cached << std::endl
+                  << "clean check gives" << std::endl << clean << std::endl;
+        return false;
+    }
+    std::cout << "PASS " << edit.name << std::endl;
+    return true;
+}
+
+int main() {
+    int failures = 0;
+    for (const Sample& sample : SAMPLES) {
+        try {
+            if (!check(sample)) {
+                ++failures;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "FAIL " << sample.name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+    for (const Edit& edit : EDITS) {
+        try {
+            if (!check(edit)) {
+                ++failures;
+            }
+        } catch (const std::exception& e) {
+            std::cout << "FAIL " << edit.name << ": " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+    std::cout << failures << " of " << std::size(SAMPLES) + std::size(EDITS) << " tests failed." << std::endl;
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
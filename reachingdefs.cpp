@@ -0,0 +1,101 @@
+// reachingdefs.cpp
+#include "../include/reachingdefs.h"
+#include "../include/dataflow.h"
+#include <unordered_set>
+
+// Key of the temp or variable an operand names
+static uint64_t targetKey(Operand operand) {
+    return static_cast<uint64_t>(operand.kind) << 32 | operand.id;
+}
+
+ReachingDefinitions::ReachingDefinitions(const IRFunction& function, const ControlFlowGraph& cfg)
+    : function(function), cfg(cfg), definitionAt(function.instructions.size(), -1) {
+    std::unordered_set<uint32_t> locals;
+    for (const auto* variables : {&function.parameters, &function.locals}) {
+        for (const IRVariable& variable : *variables) {
+            locals.insert(variable.symbol);
+        }
+    }
+    
+    for (uint32_t i = 0; i < function.instructions.size(); ++i) {
+        const Instruction& instr = function.instructions[i];
+        Operand target = instr.getResult();
+        bool isDefinition = instr.opcode == OpCode::STORE ? locals.count(target.id) > 0
+                                                           : target.kind == OperandKind::TEMP;
+        if (isDefinition) {
+            definitionAt[i] = static_cast<int>(instructions.size());
+            byTarget[targetKey(target)].push_back(static_cast<uint32_t>(instructions.size()));
+            instructions.push_back(i);
+        }
+    }
+    solve();
+}
+
+const std::vector<uint32_t>& ReachingDefinitions::getDefinitionsOf(Operand operand) const {
+    static const std::vector<uint32_t> none;
+    auto it = byTarget.find(targetKey(operand));
+    return it == byTarget.end() ? none : it->second;
+}
+
+void ReachingDefinitions::step(BitSet& reaching, uint32_t instruction) const {
+    int definition = definitionAt[instruction];
+    if (definition < 0) {
+        return;
+    }
+    for (uint32_t killed : getDefinitionsOf(function.instructions[instruction].getResult())) {
+        reaching.reset(killed);
+    }
+    reaching.set(definition);
+}
+
+BitSet ReachingDefinitions::getReachingBefore(uint32_t block, uint32_t instruction) const {
+    BitSet reaching = reachingIn[block];
+    for (uint32_t i = cfg.getBlock(block).first; i < instruction; ++i) {
+        step(reaching, i);
+    }
+    return reaching;
+}
+
+// out = gen + (in - kill), with the union as meet
+class ReachingProblem : public DataflowProblem<BitSet> {
+private:
+    uint32_t definitionCount;
+    std::vector<BitSet> gens;
+    std::vector<BitSet> kills;
+
+public:
+    ReachingProblem(const ReachingDefinitions& reaching, const IRFunction& function, const ControlFlowGraph& cfg)
+        : definitionCount(reaching.size()), gens(cfg.size(), BitSet(definitionCount)),
+          kills(cfg.size(), BitSet(definitionCount)) {
+        for (uint32_t b = 0; b < cfg.size(); ++b) {
+            const BasicBlock& bb = cfg.getBlock(b);
+            for (uint32_t i = bb.first; i < bb.last; ++i) {
+                reaching.step(gens[b], i);
+                Operand target = function.instructions[i].getResult();
+                if (target.kind == OperandKind::TEMP || target.kind == OperandKind::VARIABLE) {
+                    for (uint32_t killed : reaching.getDefinitionsOf(target)) {
+                        kills[b].set(killed);
+                    }
+                }
+            }
+        }
+    }
+    
+    DataflowDirection direction() const override { return DataflowDirection::FORWARD; }
+    BitSet boundary() const override { return BitSet(definitionCount); }
+    BitSet top() const override { return BitSet(definitionCount); }
+    void meet(BitSet& into, const BitSet& from) const override { into.unionWith(from); }
+    
+    BitSet transfer(uint32_t block, const BitSet& reachingIn) const override {
+        BitSet reachingOut = reachingIn;
+        reachingOut.subtract(kills[block]);
+        reachingOut.unionWith(gens[block]);
+        return reachingOut;
+    }
+};
+
+void ReachingDefinitions::solve() {
+    DataflowResult<BitSet> result = solveDataflow(cfg, ReachingProblem(*this, function, cfg));
+    reachingIn = std::move(result.in);
+    reachingOut = std::move(result.out);
+}
\ No newline at end of file
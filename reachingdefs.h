@@ -0,0 +1,39 @@
+// reachingdefs.h
+#pragma once
+#include "cfg.h"
+#include "bitset.h"
+#include <unordered_map>
+#include <vector>
+
+// Reaching definitions for a function outside SSA form, solved forward over
+// bitsets. Definitions are the instructions that write a temp or store to a
+// parameter or local, numbered in instruction order. A use that no
+// definition reaches along some path may see the value the variable had on
+// entry: the argument for a parameter, zero for a local.
+class ReachingDefinitions {
+private:
+    const IRFunction& function;
+    const ControlFlowGraph& cfg;
+    std::vector<uint32_t> instructions;                             // Instruction of each definition
+    std::vector<int> definitionAt;                                  // Definition of each instruction, or -1
+    std::unordered_map<uint64_t, std::vector<uint32_t>> byTarget;   // Definitions of each temp or variable
+    std::vector<BitSet> reachingIn;
+    std::vector<BitSet> reachingOut;
+    
+    void solve();
+
+public:
+    ReachingDefinitions(const IRFunction& function, const ControlFlowGraph& cfg);
+    
+    uint32_t size() const { return static_cast<uint32_t>(instructions.size()); }
+    uint32_t getInstruction(uint32_t definition) const { return instructions[definition]; }
+    // Definitions of a temp or variable operand, in instruction order
+    const std::vector<uint32_t>& getDefinitionsOf(Operand operand) const;
+    
+    const BitSet& getReachingIn(uint32_t block) const { return reachingIn[block]; }
+    const BitSet& getReachingOut(uint32_t block) const { return reachingOut[block]; }
+    // Definitions reaching an instruction of a block, before it runs
+    BitSet getReachingBefore(uint32_t block, uint32_t instruction) const;
+    // Applies the effect of one instruction to a set of reaching definitions
+    void step(BitSet& reaching, uint32_t instruction) const;
+};
\ No newline at end of file
@@ -0,0 +1,152 @@
+// regalloc.cpp
+#include "../include/regalloc.h"
+#include "../include/liveness.h"
+#include <algorithm>
+#include <iterator>
+
+// Positions of the instructions over which a temp is live
+struct LiveInterval {
+    uint32_t temp;
+    uint32_t start;
+    uint32_t end;
+    uint64_t weight;   // Uses and definitions, each counted 8 times more per enclosing loop
+};
+
+// Live intervals of the temps that occur in a function, by start
+static std::vector<LiveInterval> buildIntervals(const IRFunction& function) {
+    ControlFlowGraph cfg(function);
+    Liveness liveness(function, cfg);
+    std::vector<uint32_t> loopDepths = cfg.computeLoopDepths();
+    std::vector<LiveInterval> byTemp(function.tempCount + 1, {0, UINT32_MAX, 0, 0});
+    auto extend = [&](uint32_t temp, uint32_t position) {
+        LiveInterval& interval = byTemp[temp];
+        interval.start = std::min(interval.start, position);
+        interval.end = std::max(interval.end, position);
+    };
+    
+    for (uint32_t b = 0; b < cfg.size(); ++b) {
+        const BasicBlock& bb = cfg.getBlock(b);
+        liveness.getLiveIn(b).forEach([&](uint32_t item) {
+            if (item <= function.tempCount) {
+                extend(item, bb.first);
+            }
+        });
+        liveness.getLiveOut(b).forEach([&](uint32_t item) {
+            if (item <= function.tempCount) {
+                extend(item, bb.last - 1);
+            }
+        });
+        uint64_t weight = uint64_t(1) << (3 * std::min(loopDepths[b], 6u));
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = function.instructions[i];
+            if (instr.opcode == OpCode::LABEL) {
+                continue;
+            }
+            for (int o = Instruction::RESULT; o <= Instruction::ARG2; ++o) {
+                Operand operand = instr.getOperand(o);
+                if (operand.kind == OperandKind::TEMP) {
+                    extend(operand.id, i);
+                    byTemp[operand.id].weight += weight;
+                }
+            }
+        }
+    }
+    
+    std::vector<LiveInterval> intervals;
+    for (uint32_t temp = 1; temp <= function.tempCount; ++temp) {
+        if (byTemp[temp].start != UINT32_MAX) {
+            intervals.push_back(byTemp[temp]);
+            intervals.back().temp = temp;
+        }
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const LiveInterval& a, const LiveInterval& b) {
+        return a.start != b.start ? a.start < b.start : a.temp < b.temp;
+    });
+    return intervals;
+}
+
+void allocateRegisters(IRFunction& function, uint32_t registerCount) {
+    std::vector<Location>& locations = function.locations;
+    locations.assign(function.tempCount + 1, Location());
+    function.spillSlots = 0;
+    
+    // Intervals holding a register or a slot, each kept sorted by end
+    std::vector<LiveInterval> active;
+    std::vector<LiveInterval> spilled;
+    std::vector<uint32_t> freeRegisters;
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> slotEnds;      // Where the last interval given each slot ends
+    for (uint32_t r = registerCount; r-- > 0;) {
+        freeRegisters.push_back(r);
+    }
+    auto byEnd = [](const LiveInterval& a, const LiveInterval& b) { return a.end < b.end; };
+    auto insert = [&](std::vector<LiveInterval>& list, const LiveInterval& interval) {
+        list.insert(std::upper_bound(list.begin(), list.end(), interval, byEnd), interval);
+    };
+    auto spill = [&](const LiveInterval& interval) {
+        // An interval evicted from a register started before the current
+        // one, so a freed slot only serves it if its last owner had already
+        // ended by then
+        auto free = std::find_if(freeSlots.rbegin(), freeSlots.rend(),
+                                 [&](uint32_t slot) { return slotEnds[slot] <= interval.start; });
+        uint32_t slot = function.spillSlots;
+        if (free == freeSlots.rend()) {
+            ++function.spillSlots;
+            slotEnds.push_back(0);
+        } else {
+            slot = *free;
+            freeSlots.erase(std::next(free).base());
+        }
+        slotEnds[slot] = interval.end;
+        locations[interval.temp] = {LocationKind::SPILL, slot};
+        insert(spilled, interval);
+    };
+    
+    for (const LiveInterval& interval : buildIntervals(function)) {
+        // Release whatever ended by the time this interval starts
+        size_t expired = 0;
+        while (expired < active.size() && active[expired].end <= interval.start) {
+            freeRegisters.push_back(locations[active[expired++].temp].index);
+        }
+        active.erase(active.begin(), active.begin() + expired);
+        expired = 0;
+        while (expired < spilled.size() && spilled[expired].end <= interval.start) {
+            freeSlots.push_back(locations[spilled[expired++].temp].index);
+        }
+        spilled.erase(spilled.begin(), spilled.begin() + expired);
+        
+        if (!freeRegisters.empty()) {
+            locations[interval.temp] = {LocationKind::REGISTER, freeRegisters.back()};
+            freeRegisters.pop_back();
+            insert(active, interval);
+            continue;
+        }
+        
+        // Spill the interval used least, weighted by loop depth, and of those
+        // the one that ends last
+        size_t victim = active.size();
+        for (size_t a = active.size(); a-- > 0;) {
+            const LiveInterval& candidate = victim == active.size() ? interval : active[victim];
+            if (active[a].weight < candidate.weight ||
+                (active[a].weight == candidate.weight && active[a].end > candidate.end)) {
+                victim = a;
+            }
+        }
+        if (victim == active.size()) {
+            spill(interval);
+            continue;
+        }
+        LiveInterval spilledInterval = active[victim];
+        active.erase(active.begin() + victim);
+        locations[interval.temp] = locations[spilledInterval.temp];
+        insert(active, interval);
+        spill(spilledInterval);
+    }
+}
+
+void RegisterAllocationPass::runOnFunction(IRFunction& function, IRProgram&) {
+    if (function.ssa) {
+        return;
+    }
+    allocateRegisters(function, registerCount);
+}
\ No newline at end of file
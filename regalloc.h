@@ -0,0 +1,33 @@
+// regalloc.h
+#pragma once
+#include "optimizer.h"
+
+// Registers in the file targeted by default
+constexpr uint32_t DEFAULT_REGISTER_COUNT = 16;
+
+// Linear-scan register allocation. Each temp gets one live interval over
+// the instruction order, the hull of every point liveness finds it live,
+// and intervals are assigned registers in order of their start. When all
+// registers are taken, the interval with the fewest uses and definitions,
+// each weighted by the depth of the loops around it, is spilled to a slot
+// of the function's frame, so loops keep their values in registers. A slot
+// is reused by an interval that starts after its last owner has ended.
+// Temps whose intervals end where another starts may share a register, so
+// a MOVE between them needs no code. Results go to IRFunction::locations.
+// Passes that change temps afterwards leave the locations stale, so it
+// belongs at the end of a pipeline.
+class RegisterAllocationPass : public FunctionPass {
+private:
+    uint32_t registerCount;
+
+public:
+    explicit RegisterAllocationPass(uint32_t registerCount = DEFAULT_REGISTER_COUNT)
+        : registerCount(registerCount) {}
+    
+    const char* getName() const override { return "regalloc"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
+
+// Allocates the temps of a function outside SSA form onto registerCount
+// registers and spill slots
+void allocateRegisters(IRFunction& function, uint32_t registerCount);
\ No newline at end of file
@@ -0,0 +1,347 @@
+// sccp.cpp
+#include "../include/sccp.h"
+#include <algorithm>
+
+// Lattice value of a temp: undefined so far, one constant, or overdefined
+struct LatticeValue {
+    enum class State : uint8_t {
+        TOP,
+        CONSTANT,
+        BOTTOM
+    };
+    
+    State state = State::TOP;
+    Constant value;
+};
+
+// Operator of an arithmetic or comparison opcode, for constant evaluation
+static TokenType operatorOf(OpCode op) {
+    switch (op) {
+        case OpCode::ADD: return TokenType::PLUS;
+        case OpCode::SUB: return TokenType::MINUS;
+        case OpCode::MUL: return TokenType::MULTIPLY;
+        case OpCode::DIV: return TokenType::SLASH;
+        case OpCode::CMPEQ: return TokenType::EQUAL_EQUAL;
+        case OpCode::CMPNE: return TokenType::NOT_EQUAL;
+        case OpCode::CMPLT: return TokenType::LESS;
+        case OpCode::CMPLE: return TokenType::LESS_EQUAL;
+        case OpCode::CMPGT: return TokenType::GREATER;
+        default: return TokenType::GREATER_EQUAL;
+    }
+}
+
+static bool isTrue(const Constant& value) {
+    return value.type == TypeId::FLOAT ? value.real != 0.0f : value.integer != 0;
+}
+
+// State of the propagation over one function
+struct SCCPSolver {
+    static constexpr uint32_t NO_BLOCK = UINT32_MAX;
+    
+    IRFunction& function;
+    IRProgram& program;
+    const ControlFlowGraph& cfg;
+    std::vector<LatticeValue> values;                  // Per temp
+    std::vector<std::vector<uint32_t>> uses;           // Instructions reading each temp
+    std::vector<uint32_t> blockOf;                     // Block of each instruction
+    std::vector<bool> visited;                         // Blocks found executable
+    std::vector<uint8_t> executableEdges;              // Bit per successor of each block
+    std::vector<std::pair<uint32_t, uint32_t>> flowWorklist;
+    std::vector<uint32_t> ssaWorklist;
+    
+    SCCPSolver(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg);
+    
+    LatticeValue valueOf(Operand operand) const;
+    bool isExecutable(uint32_t from, uint32_t to) const;
+    void markEdge(uint32_t from, uint32_t to);
+    void update(Operand temp, const LatticeValue& value);
+    void visitPhi(uint32_t index);
+    void visitInstruction(uint32_t index);
+    void solve();
+    void rewrite();
+};
+
+SCCPSolver::SCCPSolver(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg)
+    : function(function), program(program), cfg(cfg), values(function.tempCount + 1), uses(function.tempCount + 1),
+      blockOf(function.instructions.size()), visited(cfg.size(), false), executableEdges(cfg.size(), 0) {
+    for (uint32_t block = 0; block < cfg.size(); ++block) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        std::fill(blockOf.begin() + bb.first, blockOf.begin() + bb.last, block);
+    }
+    
+    // Def-use edges, including those into PHIs
+    auto addUse = [this](Operand operand, uint32_t index) {
+        if (operand.kind == OperandKind::TEMP) {
+            uses[operand.id].push_back(index);
+        }
+    };
+    for (uint32_t i = 0; i < function.instructions.size(); ++i) {
+        const Instruction& instr = function.instructions[i];
+        if (instr.opcode == OpCode::PHI) {
+            uint32_t first = instr.getArg1().id;
+            for (uint32_t a = first; a < first + instr.getArg2().id; ++a) {
+                addUse(function.phiArguments[a].value, i);
+            }
+        } else if (instr.opcode != OpCode::LABEL) {
+            addUse(instr.getArg1(), i);
+            addUse(instr.getArg2(), i);
+        }
+    }
+}
+
+LatticeValue SCCPSolver::valueOf(Operand operand) const {
+    if (operand.kind == OperandKind::TEMP) {
+        return values[operand.id];
+    }
+    
+    LatticeValue value;
+    if (operand.kind == OperandKind::CONSTANT) {
+        value.state = LatticeValue::State::CONSTANT;
+        value.value = program.constants.get(operand.id);
+    } else {
+        value.state = LatticeValue::State::BOTTOM;
+    }
+    return value;
+}
+
+bool SCCPSolver::isExecutable(uint32_t from, uint32_t to) const {
+    const std::vector<uint32_t>& successors = cfg.getBlock(from).successors;
+    for (size_t i = 0; i < successors.size(); ++i) {
+        if (successors[i] == to && (executableEdges[from] & (1u << i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SCCPSolver::markEdge(uint32_t from, uint32_t to) {
+    const std::vector<uint32_t>& successors = cfg.getBlock(from).successors;
+    for (size_t i = 0; i < successors.size(); ++i) {
+        if (successors[i] == to && !(executableEdges[from] & (1u << i))) {
+            executableEdges[from] |= static_cast<uint8_t>(1u << i);
+            flowWorklist.emplace_back(from, to);
+        }
+    }
+}
+
+void SCCPSolver::update(Operand temp, const LatticeValue& value) {
+    // Values only move down the lattice, so each temp changes at most twice
+    LatticeValue& current = values[temp.id];
+    if (current.state == value.state &&
+        (value.state != LatticeValue::State::CONSTANT || current.value.equals(value.value))) {
+        return;
+    }
+    if (current.state == LatticeValue::State::CONSTANT && value.state == LatticeValue::State::CONSTANT) {
+        current.state = LatticeValue::State::BOTTOM;
+    } else {
+        current = value;
+    }
+    ssaWorklist.insert(ssaWorklist.end(), uses[temp.id].begin(), uses[temp.id].end());
+}
+
+void SCCPSolver::visitPhi(uint32_t index) {
+    // Meet of the arguments arriving over executable edges
+    const Instruction& phi = function.instructions[index];
+    uint32_t block = blockOf[index];
+    LatticeValue result;
+    uint32_t first = phi.getArg1().id;
+    for (uint32_t a = first; a < first + phi.getArg2().id; ++a) {
+        const PhiArgument& incoming = function.phiArguments[a];
+        uint32_t predecessor = cfg.blockOfLabel(incoming.label);
+        if (predecessor == NO_BLOCK || !isExecutable(predecessor, block)) {
+            continue;
+        }
+        
+        LatticeValue value = valueOf(incoming.value);
+        if (value.state == LatticeValue::State::BOTTOM ||
+            (value.state == LatticeValue::State::CONSTANT && result.state == LatticeValue::State::CONSTANT &&
+             !result.value.equals(value.value))) {
+            result.state = LatticeValue::State::BOTTOM;
+            break;
+        }
+        if (value.state == LatticeValue::State::CONSTANT) {
+            result = value;
+        }
+    }
+    update(phi.getResult(), result);
+}
+
+void SCCPSolver::visitInstruction(uint32_t index) {
+    const Instruction& instr = function.instructions[index];
+    uint32_t block = blockOf[index];
+    const std::vector<uint32_t>& successors = cfg.getBlock(block).successors;
+    LatticeValue result;
+    
+    switch (instr.opcode) {
+        case OpCode::JMP:
+            markEdge(block, cfg.blockOfLabel(instr.getArg1().id));
+            return;
+        
+        case OpCode::JZ:
+        case OpCode::JNZ: {
+            LatticeValue condition = valueOf(instr.getArg1());
+            if (condition.state == LatticeValue::State::BOTTOM) {
+                for (uint32_t successor : successors) {
+                    markEdge(block, successor);
+                }
+            } else if (condition.state == LatticeValue::State::CONSTANT) {
+                bool taken = isTrue(condition.value) == (instr.opcode == OpCode::JNZ);
+                markEdge(block, taken ? cfg.blockOfLabel(instr.getArg2().id) : block + 1);
+            }
+            return;
+        }
+        
+        case OpCode::MOVE:
+            result = valueOf(instr.getArg1());
+            break;
+        
+        case OpCode::ITOF:
+        case OpCode::FTOI: {
+            result = valueOf(instr.getArg1());
+            if (result.state == LatticeValue::State::CONSTANT) {
+                result.value = convertConstant(result.value, instr.type);
+                if (!result.value.isConstant()) {
+                    result.state = LatticeValue::State::BOTTOM;
+                }
+            }
+            break;
+        }
+        
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::DIV:
+        case OpCode::CMPEQ:
+        case OpCode::CMPNE:
+        case OpCode::CMPLT:
+        case OpCode::CMPLE:
+        case OpCode::CMPGT:
+        case OpCode::CMPGE: {
+            LatticeValue left = valueOf(instr.getArg1());
+            LatticeValue right = valueOf(instr.getArg2());
+            if (left.state == LatticeValue::State::BOTTOM || right.state == LatticeValue::State::BOTTOM) {
+                result.state = LatticeValue::State::BOTTOM;
+            } else if (left.state == LatticeValue::State::CONSTANT && right.state == LatticeValue::State::CONSTANT) {
+                result.value = evaluateBinary(operatorOf(instr.opcode), instr.type, left.value, right.value);
+                result.state = result.value.isConstant() ? LatticeValue::State::CONSTANT : LatticeValue::State::BOTTOM;
+            }
+            break;
+        }
+        
+        default:
+            // Loads, calls and anything else depend on the state at runtime
+            result.state = LatticeValue::State::BOTTOM;
+            break;
+    }
+    
+    if (instr.getResult().kind == OperandKind::TEMP) {
+        update(instr.getResult(), result);
+    }
+}
+
+void SCCPSolver::solve() {
+    // The entry block is reached by a virtual edge
+    flowWorklist.emplace_back(NO_BLOCK, 0);
+    while (!flowWorklist.empty() || !ssaWorklist.empty()) {
+        while (!flowWorklist.empty()) {
+            uint32_t block = flowWorklist.back().second;
+            flowWorklist.pop_back();
+            const BasicBlock& bb = cfg.getBlock(block);
+            
+            // PHIs are revisited for every new edge; the rest of the block once
+            uint32_t i = bb.first + 1;
+            for (; i < bb.last && function.instructions[i].opcode == OpCode::PHI; ++i) {
+                visitPhi(i);
+            }
+            if (visited[block]) {
+                continue;
+            }
+            visited[block] = true;
+            for (; i < bb.last; ++i) {
+                visitInstruction(i);
+            }
+            
+            OpCode last = function.instructions[bb.last - 1].opcode;
+            if (!isBranch(last) && last != OpCode::RET) {
+                for (uint32_t successor : bb.successors) {
+                    markEdge(block, successor);
+                }
+            }
+        }
+        
+        while (!ssaWorklist.empty()) {
+            uint32_t index = ssaWorklist.back();
+            ssaWorklist.pop_back();
+            if (!visited[blockOf[index]]) {
+                continue;
+            }
+            if (function.instructions[index].opcode == OpCode::PHI) {
+                visitPhi(index);
+            } else {
+                visitInstruction(index);
+            }
+        }
+    }
+}
+
+void SCCPSolver::rewrite() {
+    auto replace = [this](Operand operand) {
+        if (operand.kind == OperandKind::TEMP && values[operand.id].state == LatticeValue::State::CONSTANT) {
+            return constantOperand(program.constants.intern(values[operand.id].value));
+        }
+        return operand;
+    };
+    
+    std::vector<bool> removed(function.instructions.size(), false);
+    for (uint32_t i = 0; i < function.instructions.size(); ++i) {
+        Instruction& instr = function.instructions[i];
+        uint32_t block = blockOf[i];
+        if (!visited[block]) {
+            removed[i] = true;
+            continue;
+        }
+        
+        // Constant definitions are dropped; loads and calls are never constant
+        Operand result = instr.getResult();
+        if (result.kind == OperandKind::TEMP && values[result.id].state == LatticeValue::State::CONSTANT) {
+            removed[i] = true;
+            continue;
+        }
+        
+        if (instr.opcode == OpCode::PHI) {
+            uint32_t first = instr.getArg1().id;
+            for (uint32_t a = first; a < first + instr.getArg2().id; ++a) {
+                function.phiArguments[a].value = replace(function.phiArguments[a].value);
+            }
+            continue;
+        }
+        if (instr.opcode != OpCode::LABEL) {
+            instr.setOperand(Instruction::ARG1, replace(instr.getArg1()));
+            instr.setOperand(Instruction::ARG2, replace(instr.getArg2()));
+        }
+        
+        // A branch with one executable edge becomes a jump or falls through
+        if ((instr.opcode == OpCode::JZ || instr.opcode == OpCode::JNZ) &&
+            instr.getArg1().kind == OperandKind::CONSTANT) {
+            uint32_t target = cfg.blockOfLabel(instr.getArg2().id);
+            if (isExecutable(block, target) && target != block + 1) {
+                instr = Instruction(OpCode::JMP, TypeId::VOID, Operand(), instr.getArg2());
+            } else {
+                removed[i] = true;
+            }
+        }
+    }
+    removeInstructions(function, removed);
+    removeRedundantJumps(function);
+}
+
+void SCCPPass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    ControlFlowGraph cfg(function);
+    SCCPSolver solver(function, program, cfg);
+    solver.solve();
+    solver.rewrite();
+}
\ No newline at end of file
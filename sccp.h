@@ -0,0 +1,15 @@
+// sccp.h
+#pragma once
+#include "optimizer.h"
+
+// Sparse conditional constant propagation (Wegman and Zadeck) on SSA form.
+// Lattice values flow along SSA def-use edges, and only through CFG edges
+// found executable, so constants reaching a PHI over a branch that is never
+// taken do not spoil it. Temps proven constant are replaced by the constant,
+// branches on constant conditions become jumps or fall-throughs, and blocks
+// never reached are removed.
+class SCCPPass : public FunctionPass {
+public:
+    const char* getName() const override { return "sccp"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
@@ -0,0 +1,385 @@
+// ssa.cpp
+#include "../include/ssa.h"
+#include <algorithm>
+#include <unordered_map>
+
+// A PHI being placed for one promoted variable
+struct PendingPhi {
+    uint32_t variable;
+    Operand result;
+    std::vector<PhiArgument> arguments;
+};
+
+// A copy on a control-flow edge
+struct Copy {
+    Operand destination;
+    Operand source;
+    TypeId type;
+};
+
+// State of SSA construction for one function
+struct SSABuilder {
+    IRFunction& function;
+    IRProgram& program;
+    const ControlFlowGraph& cfg;
+    std::vector<IRVariable> variables;
+    std::unordered_map<uint32_t, uint32_t> variableIndex;   // Symbol to index in variables
+    std::vector<std::vector<PendingPhi>> phis;              // Per block
+    std::vector<std::vector<Operand>> stacks;               // Reaching values of each variable
+    std::vector<std::vector<Instruction>> bodies;           // Renamed code of each block, without its label
+    std::vector<Instruction> parameterLoads;
+    
+    SSABuilder(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg);
+    
+    int promoted(Operand variable) const;
+    Operand current(uint32_t variable);
+    void placePhis();
+    void rename(uint32_t block);
+    void emit();
+};
+
+// Gives every block a label and the function a fresh entry block, so blocks
+// can be named by label and the entry has no predecessors
+static void labelBlocks(IRFunction& function) {
+    std::vector<Instruction> labeled;
+    labeled.reserve(function.instructions.size() + function.instructions.size() / 4 + 1);
+    labeled.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), function.newLabel());
+    
+    bool startsBlock = false;
+    for (const Instruction& instr : function.instructions) {
+        if (startsBlock && instr.opcode != OpCode::LABEL) {
+            labeled.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), function.newLabel());
+        }
+        labeled.push_back(instr);
+        startsBlock = isBranch(instr.opcode) || instr.opcode == OpCode::RET;
+    }
+    function.instructions = std::move(labeled);
+}
+
+SSABuilder::SSABuilder(IRFunction& function, IRProgram& program, const ControlFlowGraph& cfg)
+    : function(function), program(program), cfg(cfg), phis(cfg.size()), bodies(cfg.size()) {
+    variables = function.parameters;
+    variables.insert(variables.end(), function.locals.begin(), function.locals.end());
+    for (uint32_t i = 0; i < variables.size(); ++i) {
+        variableIndex.emplace(variables[i].symbol, i);
+    }
+    stacks.resize(variables.size());
+}
+
+int SSABuilder::promoted(Operand variable) const {
+    auto it = variableIndex.find(variable.id);
+    return it == variableIndex.end() ? -1 : static_cast<int>(it->second);
+}
+
+Operand SSABuilder::current(uint32_t variable) {
+    if (!stacks[variable].empty()) {
+        return stacks[variable].back();
+    }
+    
+    // Read before any store; the value is unspecified, so use zero
+    Constant zero;
+    zero.type = variables[variable].type;
+    return constantOperand(program.constants.intern(zero));
+}
+
+void SSABuilder::placePhis() {
+    // Blocks storing to each variable; parameters are defined on entry
+    std::vector<std::vector<uint32_t>> definitions(variables.size());
+    for (uint32_t i = 0; i < function.parameters.size(); ++i) {
+        definitions[i].push_back(0);
+    }
+    for (uint32_t block : cfg.getReversePostorder()) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t i = bb.first; i < bb.last; ++i) {
+            const Instruction& instr = function.instructions[i];
+            int variable = instr.opcode == OpCode::STORE ? promoted(instr.getResult()) : -1;
+            if (variable >= 0 && (definitions[variable].empty() || definitions[variable].back() != block)) {
+                definitions[variable].push_back(block);
+            }
+        }
+    }
+    
+    // A variable needs a PHI on the iterated dominance frontier of its stores
+    std::vector<std::vector<uint32_t>> frontiers = cfg.computeDominanceFrontiers();
+    std::vector<uint32_t> hasPhi(cfg.size(), UINT32_MAX);
+    std::vector<uint32_t> queued(cfg.size(), UINT32_MAX);
+    std::vector<uint32_t> worklist;
+    for (uint32_t variable = 0; variable < variables.size(); ++variable) {
+        worklist = definitions[variable];
+        for (uint32_t block : worklist) {
+            queued[block] = variable;
+        }
+        while (!worklist.empty()) {
+            uint32_t block = worklist.back();
+            worklist.pop_back();
+            for (uint32_t join : frontiers[block]) {
+                if (hasPhi[join] == variable) {
+                    continue;
+                }
+                hasPhi[join] = variable;
+                phis[join].push_back({variable, function.newTemp(), {}});
+                if (queued[join] != variable) {
+                    queued[join] = variable;
+                    worklist.push_back(join);
+                }
+            }
+        }
+    }
+}
+
+void SSABuilder::rename(uint32_t block) {
+    std::vector<uint32_t> pushed;
+    for (const PendingPhi& phi : phis[block]) {
+        stacks[phi.variable].push_back(phi.result);
+        pushed.push_back(phi.variable);
+    }
+    
+    // Parameters arrive in their frame slots and are loaded once on entry
+    if (block == 0) {
+        for (uint32_t i = 0; i < function.parameters.size(); ++i) {
+            Operand value = function.newTemp();
+            parameterLoads.emplace_back(OpCode::LOAD, function.parameters[i].type, value,
+                                        variableOperand(function.parameters[i].symbol));
+            stacks[i].push_back(value);
+            pushed.push_back(i);
+        }
+    }
+    
+    // Stores define the variable's new value and loads become copies of it
+    const BasicBlock& bb = cfg.getBlock(block);
+    std::vector<Instruction>& body = bodies[block];
+    for (uint32_t i = bb.first + 1; i < bb.last; ++i) {
+        const Instruction& instr = function.instructions[i];
+        int variable = -1;
+        if (instr.opcode == OpCode::STORE && (variable = promoted(instr.getResult())) >= 0) {
+            stacks[variable].push_back(instr.getArg1());
+            pushed.push_back(variable);
+        } else if (instr.opcode == OpCode::LOAD && (variable = promoted(instr.getArg1())) >= 0) {
+            body.emplace_back(OpCode::MOVE, instr.type, instr.getResult(), current(variable));
+        } else {
+            body.push_back(instr);
+        }
+    }
+    
+    for (uint32_t successor : bb.successors) {
+        for (PendingPhi& phi : phis[successor]) {
+            phi.arguments.push_back({bb.label, current(phi.variable)});
+        }
+    }
+    
+    for (uint32_t child : cfg.getDominatorChildren(block)) {
+        rename(child);
+    }
+    
+    for (uint32_t variable : pushed) {
+        stacks[variable].pop_back();
+    }
+}
+
+void SSABuilder::emit() {
+    // Blocks keep their order; unreachable ones are dropped
+    std::vector<Instruction> instructions;
+    instructions.reserve(function.instructions.size() + parameterLoads.size());
+    function.phiArguments.clear();
+    for (uint32_t block = 0; block < cfg.size(); ++block) {
+        if (!cfg.isReachable(block)) {
+            continue;
+        }
+        
+        instructions.push_back(function.instructions[cfg.getBlock(block).first]);
+        if (block == 0) {
+            instructions.insert(instructions.end(), parameterLoads.begin(), parameterLoads.end());
+        }
+        for (const PendingPhi& phi : phis[block]) {
+            uint32_t first = static_cast<uint32_t>(function.phiArguments.size());
+            function.phiArguments.insert(function.phiArguments.end(), phi.arguments.begin(), phi.arguments.end());
+            instructions.emplace_back(OpCode::PHI, variables[phi.variable].type, phi.result,
+                                      immediateOperand(first), immediateOperand(static_cast<uint32_t>(phi.arguments.size())));
+        }
+        instructions.insert(instructions.end(), bodies[block].begin(), bodies[block].end());
+    }
+    function.instructions = std::move(instructions);
+}
+
+void SSAConstructionPass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (function.ssa || function.instructions.empty()) {
+        return;
+    }
+    
+    labelBlocks(function);
+    ControlFlowGraph cfg(function);
+    SSABuilder builder(function, program, cfg);
+    builder.placePhis();
+    builder.rename(0);
+    builder.emit();
+    function.ssa = true;
+}
+
+// Orders a parallel copy into MOVEs so no destination is overwritten
+// before it is read; a cycle is broken by saving one value in a new temp
+static void sequenceCopies(std::vector<Copy> copies, IRFunction& function, std::vector<Instruction>& out) {
+    copies.erase(std::remove_if(copies.begin(), copies.end(),
+                                [](const Copy& copy) { return copy.destination == copy.source; }),
+                 copies.end());
+    
+    while (!copies.empty()) {
+        auto ready = std::find_if(copies.begin(), copies.end(), [&copies](const Copy& copy) {
+            return std::none_of(copies.begin(), copies.end(),
+                                [&copy](const Copy& other) { return other.source == copy.destination; });
+        });
+        if (ready != copies.end()) {
+            out.emplace_back(OpCode::MOVE, ready->type, ready->destination, ready->source);
+            copies.erase(ready);
+            continue;
+        }
+        
+        // Only cycles remain
+        Copy& first = copies.front();
+        Operand saved = function.newTemp();
+        out.emplace_back(OpCode::MOVE, first.type, saved, first.destination);
+        for (Copy& copy : copies) {
+            if (copy.source == first.destination) {
+                copy.source = saved;
+            }
+        }
+    }
+}
+
+// Removes labels no branch refers to
+static void removeUnusedLabels(IRFunction& function) {
+    std::vector<bool> referenced(function.labelCount + 1, false);
+    for (const Instruction& instr : function.instructions) {
+        if (instr.opcode == OpCode::JMP) {
+            referenced[instr.getArg1().id] = true;
+        } else if (instr.opcode == OpCode::JZ || instr.opcode == OpCode::JNZ) {
+            referenced[instr.getArg2().id] = true;
+        }
+    }
+    
+    std::vector<bool> removed(function.instructions.size(), false);
+    for (size_t i = 0; i < function.instructions.size(); ++i) {
+        const Instruction& instr = function.instructions[i];
+        removed[i] = instr.opcode == OpCode::LABEL && !referenced[instr.getArg1().id];
+    }
+    removeInstructions(function, removed);
+}
+
+void SSADestructionPass::runOnFunction(IRFunction& function, IRProgram&) {
+    if (!function.ssa) {
+        return;
+    }
+    
+    // Copies for each edge into a block with PHIs go at the end of the
+    // predecessor, at the start of the block, or on a new edge block
+    struct EdgeBlock {
+        uint32_t label;
+        uint32_t target;
+        std::vector<Copy> copies;
+    };
+    ControlFlowGraph cfg(function);
+    const std::vector<Instruction>& instructions = function.instructions;
+    std::vector<std::vector<Copy>> endCopies(cfg.size());
+    std::vector<std::vector<Copy>> startCopies(cfg.size());
+    std::vector<EdgeBlock> fallthroughEdges(cfg.size(), {0, 0, {}});
+    std::vector<uint32_t> retargeted(cfg.size(), 0);
+    std::vector<EdgeBlock> branchEdges;
+    
+    for (uint32_t block : cfg.getReversePostorder()) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        for (uint32_t predecessor : bb.predecessors) {
+            const BasicBlock& pred = cfg.getBlock(predecessor);
+            if (!cfg.isReachable(predecessor)) {
+                continue;
+            }
+            
+            std::vector<Copy> copies;
+            for (uint32_t i = bb.first + 1; i < bb.last && instructions[i].opcode == OpCode::PHI; ++i) {
+                const Instruction& phi = instructions[i];
+                uint32_t first = phi.getArg1().id;
+                for (uint32_t a = first; a < first + phi.getArg2().id; ++a) {
+                    if (function.phiArguments[a].label == pred.label) {
+                        copies.push_back({phi.getResult(), function.phiArguments[a].value, phi.type});
+                        break;
+                    }
+                }
+            }
+            if (copies.empty()) {
+                continue;
+            }
+            
+            if (pred.successors.size() == 1) {
+                endCopies[predecessor] = std::move(copies);
+            } else if (bb.predecessors.size() == 1) {
+                startCopies[block] = std::move(copies);
+            } else {
+                // Critical edge: either the branch target or the fall-through
+                uint32_t label = function.newLabel().id;
+                const Instruction& last = instructions[pred.last - 1];
+                if (last.opcode != OpCode::JMP && isBranch(last.opcode) && last.getArg2().id == bb.label) {
+                    retargeted[predecessor] = label;
+                    branchEdges.push_back({label, bb.label, std::move(copies)});
+                } else {
+                    fallthroughEdges[predecessor] = {label, bb.label, std::move(copies)};
+                }
+            }
+        }
+    }
+    
+    std::vector<Instruction> out;
+    out.reserve(instructions.size());
+    for (uint32_t block = 0; block < cfg.size(); ++block) {
+        if (!cfg.isReachable(block)) {
+            continue;
+        }
+        
+        const BasicBlock& bb = cfg.getBlock(block);
+        out.push_back(instructions[bb.first]);
+        sequenceCopies(startCopies[block], function, out);
+        
+        bool terminated = false;
+        for (uint32_t i = bb.first + 1; i < bb.last; ++i) {
+            Instruction instr = instructions[i];
+            if (instr.opcode == OpCode::PHI) {
+                continue;
+            }
+            if (i + 1 == bb.last && (isBranch(instr.opcode) || instr.opcode == OpCode::RET)) {
+                // A branch testing a value the copies overwrite tests a saved copy of it
+                const std::vector<Copy>& copies = endCopies[block];
+                if (instr.opcode != OpCode::JMP && isBranch(instr.opcode) &&
+                    std::any_of(copies.begin(), copies.end(),
+                                [&instr](const Copy& copy) { return copy.destination == instr.getArg1(); })) {
+                    Operand saved = function.newTemp();
+                    out.emplace_back(OpCode::MOVE, instr.type, saved, instr.getArg1());
+                    instr.setOperand(Instruction::ARG1, saved);
+                }
+                sequenceCopies(copies, function, out);
+                if (retargeted[block]) {
+                    instr.setOperand(Instruction::ARG2, Operand(OperandKind::LABEL, retargeted[block]));
+                }
+                terminated = true;
+            }
+            out.push_back(instr);
+        }
+        if (!terminated) {
+            sequenceCopies(endCopies[block], function, out);
+        }
+        
+        const EdgeBlock& edge = fallthroughEdges[block];
+        if (edge.label) {
+            out.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), Operand(OperandKind::LABEL, edge.label));
+            sequenceCopies(edge.copies, function, out);
+        }
+    }
+    
+    // Edge blocks for branches go after the last block, which always ends in a return or jump
+    for (const EdgeBlock& edge : branchEdges) {
+        out.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), Operand(OperandKind::LABEL, edge.label));
+        sequenceCopies(edge.copies, function, out);
+        out.emplace_back(OpCode::JMP, TypeId::VOID, Operand(), Operand(OperandKind::LABEL, edge.target));
+    }
+    
+    function.instructions = std::move(out);
+    function.phiArguments.clear();
+    function.ssa = false;
+    removeUnusedLabels(function);
+}
\ No newline at end of file
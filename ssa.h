@@ -0,0 +1,23 @@
+// ssa.h
+#pragma once
+#include "optimizer.h"
+
+// Converts a function to SSA form. Every block is given a label, parameters
+// and locals are promoted to temps, PHIs are placed on the iterated
+// dominance frontiers of their stores, and a walk over the dominator tree
+// renames each load to the reaching value. Globals stay in memory.
+class SSAConstructionPass : public FunctionPass {
+public:
+    const char* getName() const override { return "ssa"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
+
+// Translates out of SSA form. Each PHI becomes a parallel copy on the
+// edges into its block, sequenced into MOVEs with a temp to break cycles.
+// Critical edges get a block of their own so no copy runs on a path that
+// does not lead to the PHI.
+class SSADestructionPass : public FunctionPass {
+public:
+    const char* getName() const override { return "out-of-ssa"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
@@ -1,59 +1,64 @@
-#include "../include/symboltable.h"
-
-bool Scope::define(const Symbol& symbol) {
-    if (contains(symbol.name)) {
-        return false;
-    }
-    
-    symbols[symbol.name] = symbol;
-    return true;
-}
-
-Symbol* Scope::resolve(const std::string& name) {
-    if (contains(name)) {
-        return &symbols[name];
-    }
-    return nullptr;
-}
-
-bool Scope::contains(const std::string& name) const {
-    return symbols.find(name) != symbols.end();
-}
-
-SymbolTable::SymbolTable() {
-    // Create global scope
-    enterScope();
-}
-
-void SymbolTable::enterScope() {
-    scopes.push_back(std::make_unique<Scope>());
-}
-
-void SymbolTable::exitScope() {
-    if (scopes.size() > 1) { // Keep at least one scope (global)
-        scopes.pop_back();
-    }
-}
-
-bool SymbolTable::define(const Symbol& symbol) {
-    return scopes.back()->define(symbol);
-}
-
-Symbol* SymbolTable::resolve(const std::string& name) {
-    // Search from innermost to outermost scope
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        if (Symbol* symbol = (*it)->resolve(name)) {
-            return symbol;
-        }
-    }
-    return nullptr;
-}
-
-Symbol* SymbolTable::resolveLocal(const std::string& name) {
-    // Only look in current scope
-    return scopes.back()->resolve(name);
-}
-
-bool SymbolTable::isGlobalScope() const {
-    return scopes.size() == 1;
-} 
\ No newline at end of file
+#include "../include/symboltable.h"
+
+SymbolTable::SymbolTable() {
+    // Create global scope
+    enterScope();
+}
+
+void SymbolTable::enterScope() {
+    scopeMarks.emplace_back(active.size(), static_cast<int>(symbols.size()));
+}
+
+void SymbolTable::exitScope() {
+    if (scopeMarks.size() <= 1) { // Keep at least one scope (global)
+        return;
+    }
+
+    // Restore whatever each name bound before this scope, innermost first
+    size_t mark = scopeMarks.back().first;
+    while (active.size() > mark) {
+        int index = active.back();
+        active.pop_back();
+        visible[symbols[index].name] = shadowed[index];
+    }
+    scopeMarks.pop_back();
+}
+
+int SymbolTable::addHidden(Symbol&& symbol) {
+    symbols.push_back(std::move(symbol));
+    shadowed.push_back(-1);
+    return static_cast<int>(symbols.size()) - 1;
+}
+
+int SymbolTable::define(Symbol&& symbol) {
+    if (resolveLocal(symbol.name) >= 0) {
+        return -1;
+    }
+    symbols.push_back(std::move(symbol));
+    return bind(static_cast<int>(symbols.size()) - 1);
+}
+
+int SymbolTable::bind(int index) {
+    // Names seen before keep their map entry (-1 when nothing is visible)
+    auto entry = visible.try_emplace(symbols[index].name, -1).first;
+    shadowed.push_back(entry->second);
+    entry->second = index;
+    active.push_back(index);
+    return index;
+}
+
+int SymbolTable::resolve(std::string_view name) const {
+    // Innermost visible binding, if any
+    auto it = visible.find(name);
+    return it != visible.end() ? it->second : -1;
+}
+
+int SymbolTable::resolveLocal(std::string_view name) const {
+    // Only symbols defined since the current scope opened
+    int index = resolve(name);
+    return index >= scopeMarks.back().second ? index : -1;
+}
+
+bool SymbolTable::isGlobalScope() const {
+    return scopeMarks.size() == 1;
+}
\ No newline at end of file
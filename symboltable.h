@@ -1,61 +1,77 @@
-#pragma once
-
-#include "token.hpp"
-#include <string>
-#include <unordered_map>
-#include <vector>
-#include <memory>
-
-class Symbol {
-public:
-    enum class SymbolKind {
-        VARIABLE,
-        FUNCTION,
-        PARAMETER
-    };
-    
-    std::string name;
-    TokenType type;
-    bool isPointer;
-    SymbolKind kind;
-    
-    // For functions
-    TokenType returnType;
-    std::vector<std::pair<std::string, TokenType>> parameters;
-    
-    Symbol() : isPointer(false), kind(SymbolKind::VARIABLE) {}
-    
-    Symbol(std::string name, TokenType type, bool isPointer, SymbolKind kind)
-        : name(std::move(name)), type(type), isPointer(isPointer), kind(kind) {}
-    
-    // Constructor for functions
-    Symbol(std::string name, TokenType returnType, std::vector<std::pair<std::string, TokenType>> parameters)
-        : name(std::move(name)), returnType(returnType), parameters(std::move(parameters)), 
-          kind(SymbolKind::FUNCTION), isPointer(false) {}
-};
-
-class Scope {
-private:
-    std::unordered_map<std::string, Symbol> symbols;
-    
-public:
-    bool define(const Symbol& symbol);
-    Symbol* resolve(const std::string& name);
-    bool contains(const std::string& name) const;
-};
-
-class SymbolTable {
-private:
-    std::vector<std::unique_ptr<Scope>> scopes;
-    
-public:
-    SymbolTable();
-    
-    void enterScope();
-    void exitScope();
-    
-    bool define(const Symbol& symbol);
-    Symbol* resolve(const std::string& name);
-    Symbol* resolveLocal(const std::string& name);
-    bool isGlobalScope() const;
-}; 
\ No newline at end of file
+#pragma once
+
+#include "token.hpp"
+#include "types.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// Compact symbol record. Names point into the AST, which outlives every
+// symbol; types, including function signatures, live in the TypeTable.
+class Symbol {
+public:
+    enum class SymbolKind : uint8_t {
+        VARIABLE,
+        FUNCTION,
+        PARAMETER
+    };
+
+    std::string_view name;
+    TypeRef type;         // Declared type, or signature for functions
+    SymbolKind kind;
+    int slot;             // Frame slot for locals/parameters, -1 for globals and functions
+
+    Symbol() : type(ERROR_TYPE), kind(SymbolKind::VARIABLE), slot(-1) {}
+
+    Symbol(std::string_view name, TypeRef type, SymbolKind kind, int slot = -1)
+        : name(name), type(type), kind(kind), slot(slot) {}
+};
+
+// Scoped symbol table. Symbols are stored once, in definition order, and
+// indices into that list stay valid after their scope closes. Each visible
+// name maps to its innermost symbol; a shadow chain restores outer bindings
+// on scope exit, so entering scopes and defining symbols do not allocate
+// once the tables have warmed up.
+class SymbolTable {
+private:
+    std::vector<Symbol> symbols;
+    std::vector<int> shadowed;                       // Previous binding of each symbol's name
+    std::unordered_map<std::string_view, int> visible;
+    std::vector<int> active;                         // Symbols of all open scopes
+    std::vector<std::pair<size_t, int>> scopeMarks;  // (active size, first symbol) per scope
+
+    int bind(int index);
+
+public:
+    SymbolTable();
+
+    void enterScope();
+    void exitScope();
+
+    // Define a symbol in the current scope; returns its index or -1 if the
+    // name is already defined in that scope
+    int define(Symbol&& symbol);
+    template <typename... Args>
+    int emplace(std::string_view name, Args&&... args);
+    // Add a symbol no name resolves to, such as a compiler temporary
+    int addHidden(Symbol&& symbol);
+
+    int resolve(std::string_view name) const;
+    int resolveLocal(std::string_view name) const;
+    bool isGlobalScope() const;
+
+    const Symbol& get(int index) const { return symbols[index]; }
+    const std::vector<Symbol>& getSymbols() const { return symbols; }
+};
+
+template <typename... Args>
+int SymbolTable::emplace(std::string_view name, Args&&... args) {
+    if (resolveLocal(name) >= 0) {
+        return -1;
+    }
+    symbols.emplace_back(name, std::forward<Args>(args)...);
+    return bind(static_cast<int>(symbols.size()) - 1);
+}
\ No newline at end of file
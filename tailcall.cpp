@@ -0,0 +1,227 @@
+// tailcall.cpp
+#include "../include/tailcall.h"
+#include <unordered_set>
+
+// A self call that can become a jump: its result is returned as it is, or
+// combined with another operand and then returned
+struct TailSite {
+    uint32_t call;
+    uint32_t combination;    // Index of the ADD or MUL, or of the RET if there is none
+    uint32_t ret;            // Last instruction the jump replaces
+    OpCode combine;          // ADD or MUL, or RET if the result is returned as it is
+    Operand operand;         // The other operand of the combination
+};
+
+// Instructions that may run before the call instead of after it: they
+// read only temps and the function's own variables, which the callee
+// cannot change
+static bool canMoveBeforeCall(const Instruction& instr, const std::unordered_set<uint32_t>& variables, Operand result) {
+    if (instr.getArg1() == result || instr.getArg2() == result) {
+        return false;
+    }
+    switch (instr.opcode) {
+        case OpCode::LOAD:
+            return variables.count(instr.getArg1().id) > 0;
+        case OpCode::MOVE:
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::CMPEQ:
+        case OpCode::CMPNE:
+        case OpCode::CMPLT:
+        case OpCode::CMPLE:
+        case OpCode::CMPGT:
+        case OpCode::CMPGE:
+        case OpCode::ITOF:
+        case OpCode::FTOI:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Finds the tail site of the self call at the given index, with its
+// arguments pushed right before it
+static bool findTailSite(const IRFunction& function, const std::unordered_set<uint32_t>& variables,
+                         const std::vector<uint32_t>& labelIndex, uint32_t call, TailSite& site) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    const Instruction& instr = instructions[call];
+    uint32_t argumentCount = instr.getArg2().id;
+    if (argumentCount != function.parameters.size() || argumentCount > call) {
+        return false;
+    }
+    for (uint32_t i = call - argumentCount; i < call; ++i) {
+        if (instructions[i].opcode != OpCode::PUSH) {
+            return false;
+        }
+    }
+    Operand result = instr.getResult();
+    site.call = call;
+    
+    // A call without a result is a tail call if nothing but labels and
+    // jumps lead from it to a return
+    if (result.isNone()) {
+        uint32_t next = call + 1;
+        for (uint32_t hops = 0; next < instructions.size() && hops < instructions.size(); ++hops) {
+            const Instruction& at = instructions[next];
+            if (at.opcode == OpCode::LABEL) {
+                ++next;
+            } else if (at.opcode == OpCode::JMP) {
+                next = labelIndex[at.getArg1().id];
+            } else {
+                break;
+            }
+        }
+        site.combination = call + 1;
+        site.ret = call;
+        site.combine = OpCode::RET;
+        return next < instructions.size() && instructions[next].opcode == OpCode::RET;
+    }
+    
+    uint32_t next = call + 1;
+    while (next < instructions.size() && canMoveBeforeCall(instructions[next], variables, result)) {
+        ++next;
+    }
+    if (next >= instructions.size()) {
+        return false;
+    }
+    site.combination = next;
+    site.ret = next;
+    
+    const Instruction& combination = instructions[next];
+    if (combination.opcode == OpCode::RET && combination.getArg1() == result) {
+        site.combine = OpCode::RET;
+        return true;
+    }
+    if ((combination.opcode != OpCode::ADD && combination.opcode != OpCode::MUL) || combination.type != TypeId::INT ||
+        next + 1 >= instructions.size()) {
+        return false;
+    }
+    const Instruction& ret = instructions[next + 1];
+    if (ret.opcode != OpCode::RET || ret.getArg1() != combination.getResult()) {
+        return false;
+    }
+    if (combination.getArg1() == result && combination.getArg2() != result) {
+        site.operand = combination.getArg2();
+    } else if (combination.getArg2() == result && combination.getArg1() != result) {
+        site.operand = combination.getArg1();
+    } else {
+        return false;
+    }
+    site.combine = combination.opcode;
+    site.ret = next + 1;
+    return true;
+}
+
+void TailCallPass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (function.ssa || function.symbol < 0) {
+        return;
+    }
+    std::vector<Instruction>& instructions = function.instructions;
+    uint32_t symbol = static_cast<uint32_t>(function.symbol);
+    std::vector<uint32_t> labelIndex(function.labelCount + 1, 0);
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        if (instructions[i].opcode == OpCode::LABEL) {
+            labelIndex[instructions[i].getArg1().id] = i;
+        }
+    }
+    std::unordered_set<uint32_t> variables;
+    for (const auto* list : {&function.parameters, &function.locals}) {
+        for (const IRVariable& variable : *list) {
+            variables.insert(variable.symbol);
+        }
+    }
+    
+    // Accumulating sites must all combine the same way
+    std::vector<TailSite> sites;
+    OpCode accumulate = OpCode::RET;
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        TailSite site;
+        if (instr.opcode != OpCode::CALL || instr.getArg1().id != symbol || !findTailSite(function, variables, labelIndex, i, site)) {
+            continue;
+        }
+        if (site.combine != OpCode::RET &&
+            ((accumulate != OpCode::RET && site.combine != accumulate) || function.returnValue.type != TypeId::INT)) {
+            continue;
+        }
+        if (site.combine != OpCode::RET) {
+            accumulate = site.combine;
+        }
+        sites.push_back(site);
+    }
+    if (sites.empty()) {
+        return;
+    }
+    
+    std::vector<int> siteAt(instructions.size(), -1);
+    for (uint32_t s = 0; s < sites.size(); ++s) {
+        siteAt[sites[s].call] = static_cast<int>(s);
+    }
+    Operand accumulator = variableOperand(function.returnValue.symbol);
+    Operand entry = function.newLabel();
+    
+    // A call would start the locals out as zero, so each round does too;
+    // the accumulator carries over between rounds
+    std::vector<Instruction> resetLocals;
+    for (const IRVariable& local : function.locals) {
+        if (local.symbol != function.returnValue.symbol) {
+            Constant zero;
+            zero.type = local.type;
+            resetLocals.emplace_back(OpCode::STORE, local.type, variableOperand(local.symbol),
+                                     constantOperand(program.constants.intern(zero)));
+        }
+    }
+    
+    // The accumulator starts at the identity of its combination, before the
+    // label tail calls jump back to
+    std::vector<Instruction> rewritten;
+    rewritten.reserve(instructions.size() + (2 + resetLocals.size()) * sites.size() + 2);
+    if (accumulate != OpCode::RET) {
+        Constant identity;
+        identity.type = TypeId::INT;
+        identity.integer = accumulate == OpCode::MUL ? 1 : 0;
+        rewritten.emplace_back(OpCode::STORE, TypeId::INT, accumulator, constantOperand(program.constants.intern(identity)));
+        if (!variables.count(function.returnValue.symbol)) {
+            function.locals.push_back(function.returnValue);
+        }
+    }
+    rewritten.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), entry);
+    
+    for (uint32_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instr = instructions[i];
+        if (siteAt[i] >= 0) {
+            // What followed the call runs first, then the pushed arguments
+            // become the parameters of the next round
+            const TailSite& site = sites[siteAt[i]];
+            uint32_t argumentCount = instr.getArg2().id;
+            rewritten.erase(rewritten.end() - argumentCount, rewritten.end());
+            rewritten.insert(rewritten.end(), instructions.begin() + i + 1, instructions.begin() + site.combination);
+            for (uint32_t p = 0; p < argumentCount; ++p) {
+                rewritten.emplace_back(OpCode::STORE, function.parameters[p].type,
+                                       variableOperand(function.parameters[p].symbol),
+                                       instructions[i - argumentCount + p].getArg1());
+            }
+            if (site.combine != OpCode::RET) {
+                Operand current = function.newTemp();
+                Operand combined = function.newTemp();
+                rewritten.emplace_back(OpCode::LOAD, TypeId::INT, current, accumulator);
+                rewritten.emplace_back(site.combine, TypeId::INT, combined, current, site.operand);
+                rewritten.emplace_back(OpCode::STORE, TypeId::INT, accumulator, combined);
+            }
+            rewritten.insert(rewritten.end(), resetLocals.begin(), resetLocals.end());
+            rewritten.emplace_back(OpCode::JMP, TypeId::VOID, Operand(), entry);
+            i = site.ret;
+        } else if (instr.opcode == OpCode::RET && accumulate != OpCode::RET && !instr.getArg1().isNone()) {
+            // Other returns apply what was accumulated
+            Operand current = function.newTemp();
+            Operand combined = function.newTemp();
+            rewritten.emplace_back(OpCode::LOAD, TypeId::INT, current, accumulator);
+            rewritten.emplace_back(accumulate, TypeId::INT, combined, current, instr.getArg1());
+            rewritten.emplace_back(OpCode::RET, TypeId::INT, Operand(), combined);
+        } else {
+            rewritten.push_back(instr);
+        }
+    }
+    instructions = std::move(rewritten);
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+// tailcall.h
+#pragma once
+#include "optimizer.h"
+
+// Turns self-recursion into loops before SSA construction. A self call
+// whose result is returned right away stores its arguments to the
+// parameters, sets the other locals back to zero as a call would, and
+// jumps back to the top of the function instead.
+//
+// A self call whose result is added to or multiplied by a value computed
+// before the call, and then returned, is made a tail call with an
+// accumulator: the function's hidden return value variable, which starts
+// at 0 or 1, takes in the other operand at each such call, and is applied
+// to the value of every other return. Integer addition and multiplication wrap,
+// so they stay associative and the reordering gives the same result.
+//
+// Recursion that is not a self call, or not in one of these forms, is left
+// as it is.
+class TailCallPass : public FunctionPass {
+public:
+    const char* getName() const override { return "tail-call"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file
@@ -1,564 +1,872 @@
-// typechecker.cpp
-#include "../include/typechecker.h"
-#include <iostream>
-#include <sstream>
-
-TypeChecker::TypeChecker() : inFunctionBody(false), currentFunctionReturnType(TokenType::VOID) {}
-
-void TypeChecker::check(const std::vector<std::unique_ptr<Statement>>& statements) {
-    std::vector<std::string> errors;
-    
-    // First pass: register all function declarations for forward references
-    for (const auto& stmt : statements) {
-        if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt.get())) {
-            std::vector<std::pair<std::string, TokenType>> params;
-            for (const auto& param : funcDecl->getParameters()) {
-                params.push_back(param);
-            }
-            
-            Symbol funcSymbol(funcDecl->getName(), funcDecl->getReturnType(), std::move(params));
-            if (!symbolTable.define(funcSymbol)) {
-                std::stringstream ss;
-                ss << "Function '" << funcDecl->getName() << "' already defined";
-                errors.push_back(ss.str());
-            }
-        }
-    }
-    
-    // Second pass: check all statements
-    for (const auto& stmt : statements) {
-        try {
-            checkStatement(stmt.get());
-        } catch (const TypeError& e) {
-            errors.push_back(e.what());
-        }
-    }
-    
-    // Report all errors
-    if (!errors.empty()) {
-        std::stringstream ss;
-        ss << "Found " << errors.size() << " semantic errors:" << std::endl;
-        for (const auto& error : errors) {
-            ss << "- " << error << std::endl;
-        }
-        throw TypeError(ss.str());
-    }
-}
-
-TokenType TypeChecker::checkExpression(const Expression* expr) {
-    if (auto* literalExpr = dynamic_cast<const LiteralExpression*>(expr)) {
-        return checkLiteral(literalExpr);
-    } else if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
-        return checkIdentifier(identifierExpr);
-    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
-        return checkUnary(unaryExpr);
-    } else if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
-        return checkBinary(binaryExpr);
-    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
-        return checkLogical(logicalExpr);
-    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
-        return checkAssign(assignExpr);
-    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
-        return checkCall(callExpr);
-    }
-    
-    throw TypeError("Unknown expression type");
-}
-
-TokenType TypeChecker::checkLiteral(const LiteralExpression* expr) {
-    return expr->getLiteralType();
-}
-
-TokenType TypeChecker::checkIdentifier(const IdentifierExpression* expr) {
-    Symbol* symbol = symbolTable.resolve(expr->getName());
-    if (!symbol) {
-        std::stringstream ss;
-        ss << "Undefined variable '" << expr->getName() << "'";
-        throw TypeError(ss.str());
-    }
-    
-    if (symbol->kind == Symbol::SymbolKind::FUNCTION) {
-        std::stringstream ss;
-        ss << "'" << expr->getName() << "' is a function and cannot be used as a variable";
-        throw TypeError(ss.str());
-    }
-    
-    return symbol->isPointer ? TokenType::POINTER : symbol->type;
-}
-
-TokenType TypeChecker::checkUnary(const UnaryExpression* expr) {
-    TokenType rightType = checkExpression(expr->getOperand());
-    TokenType op = expr->getOperator();
-    
-    switch (op) {
-        case TokenType::MINUS:
-        case TokenType::PLUS:
-            if (!isNumericType(rightType)) {
-                throw TypeError("Unary '+' and '-' operators require numeric operands");
-            }
-            return rightType;
-            
-        case TokenType::NOT:
-            return TokenType::BOOL;
-            
-        case TokenType::INCREMENT:
-        case TokenType::DECREMENT:
-            if (!isNumericType(rightType)) {
-                throw TypeError("Increment and decrement operators require numeric operands");
-            }
-            return rightType;
-            
-        case TokenType::MULTIPLY: // Dereference operator
-            if (rightType != TokenType::POINTER) {
-                throw TypeError("Cannot dereference non-pointer type");
-            }
-            // Return the base type, not the pointer type
-            return TokenType::INT; // Simplified - should return the actual pointed type
-            
-        case TokenType::AMPERSAND: // Address-of operator
-            // Return pointer to the type
-            return TokenType::POINTER;
-            
-        default:
-            std::stringstream ss;
-            ss << "Unsupported unary operator: " << static_cast<int>(op);
-            throw TypeError(ss.str());
-    }
-}
-
-TokenType TypeChecker::checkBinary(const BinaryExpression* expr) {
-    TokenType leftType = checkExpression(expr->getLeft());
-    TokenType rightType = checkExpression(expr->getRight());
-    TokenType op = expr->getOperator();
-    
-    // Special case for stream operators
-    if (op == TokenType::LEFT_SHIFT || op == TokenType::RIGHT_SHIFT) {
-        // Simplified check - in a real compiler, we'd verify these are actually stream objects
-        return leftType;
-    }
-    
-    // Check arithmetic operators
-    if (op == TokenType::PLUS || op == TokenType::MINUS || 
-        op == TokenType::MULTIPLY || op == TokenType::SLASH) {
-        
-        // String concatenation with +
-        if (op == TokenType::PLUS && 
-            (leftType == TokenType::STRING_LITERAL || rightType == TokenType::STRING_LITERAL)) {
-            return TokenType::STRING_LITERAL;
-        }
-        
-        // Pointer arithmetic
-        if (op == TokenType::PLUS || op == TokenType::MINUS) {
-            if (leftType == TokenType::POINTER && isNumericType(rightType)) {
-                return TokenType::POINTER;
-            }
-            if (rightType == TokenType::POINTER && op == TokenType::PLUS && isNumericType(leftType)) {
-                return TokenType::POINTER;
-            }
-        }
-        
-        // Regular arithmetic
-        if (!isNumericType(leftType) || !isNumericType(rightType)) {
-            std::stringstream ss;
-            ss << "Binary operator '" << tokenTypeToString(op) 
-               << "' requires numeric operands, got " 
-               << tokenTypeToString(leftType) << " and " 
-               << tokenTypeToString(rightType);
-            throw TypeError(ss.str());
-        }
-        
-        // Determine result type (float if either operand is float)
-        if (leftType == TokenType::FLOAT_LITERAL || rightType == TokenType::FLOAT_LITERAL) {
-            return TokenType::FLOAT_LITERAL;
-        }
-        return TokenType::INTEGER_LITERAL;
-    }
-    
-    // Comparison operators
-    if (op == TokenType::EQUAL_EQUAL || op == TokenType::NOT_EQUAL ||
-        op == TokenType::LESS || op == TokenType::LESS_EQUAL ||
-        op == TokenType::GREATER || op == TokenType::GREATER_EQUAL) {
-        
-        if (!isCompatibleType(leftType, rightType)) {
-            std::stringstream ss;
-            ss << "Cannot compare incompatible types: " 
-               << tokenTypeToString(leftType) << " and " 
-               << tokenTypeToString(rightType);
-            throw TypeError(ss.str());
-        }
-        
-        return TokenType::BOOL;
-    }
-    
-    std::stringstream ss;
-    ss << "Unsupported binary operator: " << static_cast<int>(op);
-    throw TypeError(ss.str());
-}
-
-TokenType TypeChecker::checkLogical(const LogicalExpression* expr) {
-    TokenType leftType = checkExpression(expr->getLeft());
-    TokenType rightType = checkExpression(expr->getRight());
-    
-    if (!isBooleanType(leftType)) {
-        std::stringstream ss;
-        ss << "Left operand of logical operator must be boolean, got " 
-           << tokenTypeToString(leftType);
-        throw TypeError(ss.str());
-    }
-    
-    if (!isBooleanType(rightType)) {
-        std::stringstream ss;
-        ss << "Right operand of logical operator must be boolean, got " 
-           << tokenTypeToString(rightType);
-        throw TypeError(ss.str());
-    }
-    
-    return TokenType::BOOL;
-}
-
-TokenType TypeChecker::checkAssign(const AssignExpression* expr) {
-    Symbol* symbol = symbolTable.resolve(expr->getName());
-    if (!symbol) {
-        std::stringstream ss;
-        ss << "Cannot assign to undeclared variable '" << expr->getName() << "'";
-        throw TypeError(ss.str());
-    }
-    
-    if (symbol->kind == Symbol::SymbolKind::FUNCTION) {
-        std::stringstream ss;
-        ss << "Cannot assign to function '" << expr->getName() << "'";
-        throw TypeError(ss.str());
-    }
-    
-    TokenType leftType = symbol->isPointer ? TokenType::POINTER : symbol->type;
-    TokenType rightType = checkExpression(expr->getValue());
-    
-    // Be more strict about type compatibility
-    if (leftType != rightType && !(leftType == TokenType::FLOAT && 
-        (rightType == TokenType::INTEGER_LITERAL || rightType == TokenType::INT))) {
-        std::stringstream ss;
-        ss << "Cannot assign " << tokenTypeToString(rightType) 
-           << " to variable of type " << tokenTypeToString(leftType);
-        throw TypeError(ss.str());
-    }
-    
-    return leftType;
-}
-
-TokenType TypeChecker::checkCall(const CallExpression* expr) {
-    Symbol* symbol = symbolTable.resolve(expr->getCallee());
-    if (!symbol) {
-        std::stringstream ss;
-        ss << "Undefined function '" << expr->getCallee() << "'";
-        throw TypeError(ss.str());
-    }
-    
-    if (symbol->kind != Symbol::SymbolKind::FUNCTION) {
-        std::stringstream ss;
-        ss << "'" << expr->getCallee() << "' is not a function";
-        throw TypeError(ss.str());
-    }
-    
-    const auto& params = symbol->parameters;
-    const auto& args = expr->getArguments();
-    
-    if (params.size() != args.size()) {
-        std::stringstream ss;
-        ss << "Function '" << expr->getCallee() << "' expects " 
-           << params.size() << " arguments, but got " << args.size();
-        throw TypeError(ss.str());
-    }
-    
-    for (size_t i = 0; i < args.size(); ++i) {
-        TokenType argType = checkExpression(args[i].get());
-        TokenType paramType = params[i].second;
-        
-        // Be more strict about argument types
-        if (paramType != argType && !(paramType == TokenType::FLOAT && 
-            (argType == TokenType::INTEGER_LITERAL || argType == TokenType::INT))) {
-            std::stringstream ss;
-            ss << "Argument " << (i + 1) << " to function '" << expr->getCallee() 
-               << "' has incompatible type: expected " << tokenTypeToString(paramType) 
-               << ", got " << tokenTypeToString(argType);
-            throw TypeError(ss.str());
-        }
-    }
-    
-    return symbol->returnType;
-}
-
-void TypeChecker::checkStatement(const Statement* stmt) {
-    if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
-        checkExpressionStatement(exprStmt);
-    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
-        checkBlock(blockStmt);
-    } else if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
-        checkVariableDeclaration(varDecl);
-    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
-        checkFunctionDeclaration(funcDecl);
-    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
-        checkIfStatement(ifStmt);
-    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
-        checkWhileStatement(whileStmt);
-    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
-        checkForStatement(forStmt);
-    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
-        checkReturnStatement(returnStmt);
-    } else {
-        throw TypeError("Unknown statement type");
-    }
-}
-
-void TypeChecker::checkExpressionStatement(const ExpressionStatement* stmt) {
-    checkExpression(stmt->getExpression());
-}
-
-void TypeChecker::checkBlock(const BlockStatement* stmt) {
-    symbolTable.enterScope();
-    
-    for (const auto& statement : stmt->getStatements()) {
-        checkStatement(statement.get());
-    }
-    
-    symbolTable.exitScope();
-}
-
-void TypeChecker::checkVariableDeclaration(const VariableDeclaration* stmt) {
-    TokenType type = stmt->getType();
-    bool isPointer = stmt->getIsPointer();
-    std::string name = stmt->getName();
-    
-    // Check if already defined in any scope, not just the current one
-    if (symbolTable.resolve(name)) {
-        std::stringstream ss;
-        ss << "Variable '" << name << "' already defined";
-        throw TypeError(ss.str());
-    }
-    
-    // Check initializer if present
-    if (const Expression* initializer = stmt->getInitializer()) {
-        TokenType initType = checkExpression(initializer);
-        
-        // Allow compatible types
-        if (!isCompatibleType(type, initType)) {
-            std::stringstream ss;
-            ss << "Cannot initialize variable of type " 
-               << tokenTypeToString(isPointer ? TokenType::POINTER : type) 
-               << " with value of type " << tokenTypeToString(initType);
-            throw TypeError(ss.str());
-        }
-    }
-    
-    // Add to symbol table
-    Symbol symbol(name, type, isPointer, Symbol::SymbolKind::VARIABLE);
-    symbolTable.define(symbol);
-}
-
-void TypeChecker::checkFunctionDeclaration(const FunctionDeclaration* stmt) {
-    // Function should already be in symbol table from first pass
-    Symbol* symbol = symbolTable.resolve(stmt->getName());
-    if (!symbol || symbol->kind != Symbol::SymbolKind::FUNCTION) {
-        throw TypeError("Internal error: function not found in symbol table");
-    }
-    
-    // Set current function for return checking
-    std::string previousFunction = currentFunctionName;
-    TokenType previousReturnType = currentFunctionReturnType;
-    bool previousInFunction = inFunctionBody;
-    
-    currentFunctionName = stmt->getName();
-    currentFunctionReturnType = stmt->getReturnType();
-    inFunctionBody = true;
-    
-    // Enter function scope
-    symbolTable.enterScope();
-    
-    // Add parameters to symbol table
-    for (const auto& param : stmt->getParameters()) {
-        Symbol paramSymbol(param.first, param.second, 
-                          param.second == TokenType::POINTER, 
-                          Symbol::SymbolKind::PARAMETER);
-        symbolTable.define(paramSymbol);
-    }
-    
-    // Check function body
-    checkStatement(stmt->getBody());
-    
-    // Exit function scope
-    symbolTable.exitScope();
-    
-    // Restore previous function context
-    currentFunctionName = previousFunction;
-    currentFunctionReturnType = previousReturnType;
-    inFunctionBody = previousInFunction;
-}
-
-void TypeChecker::checkIfStatement(const IfStatement* stmt) {
-    // Check condition
-    TokenType condType = checkExpression(stmt->getCondition());
-    if (!isBooleanType(condType)) {
-        std::stringstream ss;
-        ss << "If condition must be boolean, got " << tokenTypeToString(condType);
-        throw TypeError(ss.str());
-    }
-    
-    // Check then branch
-    checkStatement(stmt->getThenBranch());
-    
-    // Check else branch if present
-    if (stmt->getElseBranch()) {
-        checkStatement(stmt->getElseBranch());
-    }
-}
-
-void TypeChecker::checkWhileStatement(const WhileStatement* stmt) {
-    // Check condition
-    TokenType condType = checkExpression(stmt->getCondition());
-    if (!isBooleanType(condType)) {
-        std::stringstream ss;
-        ss << "While condition must be boolean, got " << tokenTypeToString(condType);
-        throw TypeError(ss.str());
-    }
-    
-    // Check body
-    checkStatement(stmt->getBody());
-}
-
-void TypeChecker::checkForStatement(const ForStatement* stmt) {
-    symbolTable.enterScope();
-    
-    // Check initializer if present
-    if (stmt->getInitializer()) {
-        checkStatement(stmt->getInitializer());
-    }
-    
-    // Check condition if present
-    if (stmt->getCondition()) {
-        TokenType condType = checkExpression(stmt->getCondition());
-        if (!isBooleanType(condType)) {
-            std::stringstream ss;
-            ss << "For loop condition must be boolean, got " << tokenTypeToString(condType);
-            throw TypeError(ss.str());
-        }
-    }
-    
-    // Check increment if present
-    if (stmt->getIncrement()) {
-        checkExpression(stmt->getIncrement());
-    }
-    
-    // Check body
-    checkStatement(stmt->getBody());
-    
-    symbolTable.exitScope();
-}
-
-void TypeChecker::checkReturnStatement(const ReturnStatement* stmt) {
-    if (!inFunctionBody) {
-        throw TypeError("Return statement outside of function body");
-    }
-    
-    // Check return value if present
-    if (stmt->getValue()) {
-        TokenType returnType = checkExpression(stmt->getValue());
-        
-        if (currentFunctionReturnType == TokenType::VOID) {
-            throw TypeError("Cannot return a value from void function");
-        }
-        
-        if (!isCompatibleType(currentFunctionReturnType, returnType)) {
-            std::stringstream ss;
-            ss << "Function '" << currentFunctionName << "' returns " 
-               << tokenTypeToString(currentFunctionReturnType) 
-               << " but got " << tokenTypeToString(returnType);
-            throw TypeError(ss.str());
-        }
-    } else {
-        // No return value
-        if (currentFunctionReturnType != TokenType::VOID) {
-            std::stringstream ss;
-            ss << "Function '" << currentFunctionName << "' must return a value of type " 
-               << tokenTypeToString(currentFunctionReturnType);
-            throw TypeError(ss.str());
-        }
-    }
-}
-
-bool TypeChecker::isNumericType(TokenType type) const {
-    return type == TokenType::INTEGER_LITERAL || 
-           type == TokenType::FLOAT_LITERAL || 
-           type == TokenType::INT || 
-           type == TokenType::FLOAT;
-}
-
-bool TypeChecker::isBooleanType(TokenType type) const {
-    return type == TokenType::BOOL || 
-           type == TokenType::BOOL_LITERAL || 
-           type == TokenType::TRUE || 
-           type == TokenType::FALSE;
-}
-
-bool TypeChecker::isPointerType(TokenType type) const {
-    return type == TokenType::POINTER;
-}
-
-bool TypeChecker::isCompatibleType(TokenType left, TokenType right) const {
-    // Exact match
-    if (left == right) return true;
-    
-    // Numeric type compatibility
-    if (isNumericType(left) && isNumericType(right)) return true;
-    
-    // Boolean type compatibility
-    if (isBooleanType(left) && isBooleanType(right)) return true;
-    
-    // Pointer compatibility (simplified)
-    if (isPointerType(left) && right == TokenType::INTEGER_LITERAL) return true; // Allow pointer = 0 (null)
-    
-    return false;
-}
-
-TokenType TypeChecker::getResultType(TokenType left, TokenType op, TokenType right) const {
-    // For arithmetic operators
-    if (op == TokenType::PLUS || op == TokenType::MINUS || 
-        op == TokenType::MULTIPLY || op == TokenType::SLASH) {
-        
-        if (left == TokenType::FLOAT_LITERAL || right == TokenType::FLOAT_LITERAL ||
-            left == TokenType::FLOAT || right == TokenType::FLOAT) {
-            return TokenType::FLOAT_LITERAL;
-        }
-        
-        return TokenType::INTEGER_LITERAL;
-    }
-    
-    // For comparison operators
-    if (op == TokenType::EQUAL_EQUAL || op == TokenType::NOT_EQUAL ||
-        op == TokenType::LESS || op == TokenType::LESS_EQUAL ||
-        op == TokenType::GREATER || op == TokenType::GREATER_EQUAL) {
-        return TokenType::BOOL;
-    }
-    
-    // For logical operators
-    if (op == TokenType::AND || op == TokenType::OR) {
-        return TokenType::BOOL;
-    }
-    
-    return left; // Default to left type
-}
-
-std::string TypeChecker::tokenTypeToString(TokenType type) const {
-    switch (type) {
-        case TokenType::INT: return "int";
-        case TokenType::FLOAT: return "float";
-        case TokenType::CHAR: return "char";
-        case TokenType::VOID: return "void";
-        case TokenType::BOOL: return "bool";
-        case TokenType::STRING_LITERAL: return "string";
-        case TokenType::INTEGER_LITERAL: return "int";
-        case TokenType::FLOAT_LITERAL: return "float";
-        case TokenType::CHAR_LITERAL: return "char";
-        case TokenType::BOOL_LITERAL: return "bool";
-        case TokenType::POINTER: return "pointer";
-        default: return "unknown";
-    }
-} 
\ No newline at end of file
+// typechecker.cpp
+#include "../include/typechecker.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <functional>
+
+// Structural hashes of the AST, used to tell whether a function changed
+// between runs. Each node mixes in a tag for its class, its own fields and
+// the hashes of its children.
+static size_t hashCombine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+static size_t hashString(size_t seed, const std::string& value) {
+    return hashCombine(seed, std::hash<std::string>()(value));
+}
+
+static size_t hashExpression(const Expression* expr) {
+    if (!expr) {
+        return 0;
+    }
+    
+    size_t seed = 0;
+    if (auto* literalExpr = dynamic_cast<const LiteralExpression*>(expr)) {
+        seed = hashCombine(hashString(1, literalExpr->getValue()), static_cast<size_t>(literalExpr->getLiteralType()));
+    } else if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
+        seed = hashString(2, identifierExpr->getName());
+    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        seed = hashCombine(3, static_cast<size_t>(unaryExpr->getOperator()) * 2 + unaryExpr->isPostfix());
+        seed = hashCombine(seed, hashExpression(unaryExpr->getOperand()));
+    } else if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        seed = hashCombine(4, static_cast<size_t>(binaryExpr->getOperator()));
+        seed = hashCombine(seed, hashExpression(binaryExpr->getLeft()));
+        seed = hashCombine(seed, hashExpression(binaryExpr->getRight()));
+    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        seed = hashCombine(5, static_cast<size_t>(logicalExpr->getOperator()));
+        seed = hashCombine(seed, hashExpression(logicalExpr->getLeft()));
+        seed = hashCombine(seed, hashExpression(logicalExpr->getRight()));
+    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
+        seed = hashCombine(hashString(6, assignExpr->getName()), static_cast<size_t>(assignExpr->getOperator()));
+        seed = hashCombine(seed, hashExpression(assignExpr->getValue()));
+    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
+        seed = hashString(7, callExpr->getCallee());
+        for (const auto& arg : callExpr->getArguments()) {
+            seed = hashCombine(seed, hashExpression(arg.get()));
+        }
+    }
+    return seed;
+}
+
+static size_t hashStatement(const Statement* stmt) {
+    if (!stmt) {
+        return 0;
+    }
+    
+    size_t seed = 0;
+    if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
+        seed = hashCombine(11, hashExpression(exprStmt->getExpression()));
+    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
+        seed = 12;
+        for (const auto& statement : blockStmt->getStatements()) {
+            seed = hashCombine(seed, hashStatement(statement.get()));
+        }
+    } else if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
+        seed = hashCombine(hashString(13, varDecl->getName()), static_cast<size_t>(varDecl->getType()));
+        seed = hashCombine(seed, varDecl->getIsPointer());
+        seed = hashCombine(seed, hashExpression(varDecl->getInitializer()));
+    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
+        seed = hashCombine(hashString(14, funcDecl->getName()), static_cast<size_t>(funcDecl->getReturnType()));
+        for (const auto& param : funcDecl->getParameters()) {
+            seed = hashCombine(hashString(seed, param.name), static_cast<size_t>(param.type));
+            seed = hashCombine(seed, param.isPointer);
+        }
+        seed = hashCombine(seed, hashStatement(funcDecl->getBody()));
+    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
+        seed = hashCombine(15, hashExpression(ifStmt->getCondition()));
+        seed = hashCombine(seed, hashStatement(ifStmt->getThenBranch()));
+        seed = hashCombine(seed, hashStatement(ifStmt->getElseBranch()));
+    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
+        seed = hashCombine(16, hashExpression(whileStmt->getCondition()));
+        seed = hashCombine(seed, hashStatement(whileStmt->getBody()));
+    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
+        seed = hashCombine(17, hashStatement(forStmt->getInitializer()));
+        seed = hashCombine(seed, hashExpression(forStmt->getCondition()));
+        seed = hashCombine(seed, hashExpression(forStmt->getIncrement()));
+        seed = hashCombine(seed, hashStatement(forStmt->getBody()));
+    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
+        seed = hashCombine(18, hashExpression(returnStmt->getValue()));
+    }
+    return seed;
+}
+
+TypeChecker::TypeChecker(const Binder& binder)
+    : binder(binder), types(binder.getTypes()), typeTable(&expressionTypes),
+      cache(nullptr), dependencyTable(nullptr),
+      currentFunctionReturnType(TokenType::VOID), inFunctionBody(false), currentStatement(0) {
+    diagnostics.reserve(INITIAL_DIAGNOSTIC_CAPACITY);
+}
+
+void TypeChecker::check(const std::vector<std::unique_ptr<Statement>>& statements) {
+    diagnostics.clear();
+    expressionTypes.assign(binder.getExpressionCount(), ExpressionType());
+    
+    // With a cache, functions whose results are still valid are not checked again
+    std::vector<size_t> hashes;
+    if (cache) {
+        cache->reused = 0;
+        cache->checked = 0;
+        hashes.resize(statements.size());
+        functionDependencies.assign(statements.size(), std::vector<std::string_view>());
+        dependencyTable = &functionDependencies;
+    }
+    
+    // The Binder has already resolved every name, so the symbols are frozen and
+    // each function body only reads them; bodies are checked concurrently,
+    // everything else here.
+    std::vector<size_t> functions;
+    for (size_t i = 0; i < statements.size(); ++i) {
+        if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(statements[i].get())) {
+            if (cache) {
+                hashes[i] = hashStatement(funcDecl);
+                if (reuseFunction(funcDecl, i, hashes[i])) {
+                    continue;
+                }
+            }
+            functions.push_back(i);
+        } else {
+            checkTopLevel(statements[i].get(), i);
+        }
+    }
+    checkFunctions(statements, functions);
+    
+    // Report all errors in source order so output stays deterministic
+    std::stable_sort(diagnostics.begin(), diagnostics.end(),
+                     [](const Diagnostic& a, const Diagnostic& b) { return a.statement < b.statement; });
+    
+    if (cache) {
+        for (size_t index : functions) {
+            storeFunction(static_cast<const FunctionDeclaration*>(statements[index].get()), index, hashes[index]);
+        }
+        cache->checked = functions.size();
+        dependencyTable = nullptr;
+    }
+    
+    if (diagnostics.empty()) {
+        return;
+    }
+    
+    std::stringstream ss;
+    ss << "Found " << diagnostics.size() << " semantic errors:" << std::endl;
+    for (const auto& diagnostic : diagnostics) {
+        ss << "- " << formatDiagnostic(diagnostic) << std::endl;
+    }
+    throw TypeError(ss.str());
+}
+
+void TypeChecker::checkTopLevel(const Statement* stmt, size_t index) {
+    currentStatement = static_cast<uint32_t>(index);
+    checkStatement(stmt);
+}
+
+void TypeChecker::checkFunctions(const std::vector<std::unique_ptr<Statement>>& statements,
+                                 const std::vector<size_t>& functions) {
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    size_t workers = std::min(cores, functions.size() / MIN_FUNCTIONS_PER_WORKER);
+    
+    // Each worker has its own checker, and with it its own function context and
+    // diagnostics; functions are handed out one at a time to balance uneven bodies
+    std::atomic<size_t> next(0);
+    auto work = [&](std::vector<Diagnostic>& found) {
+        TypeChecker worker(binder);
+        worker.typeTable = typeTable;
+        worker.dependencyTable = dependencyTable;
+        for (size_t i = next++; i < functions.size(); i = next++) {
+            worker.checkTopLevel(statements[functions[i]].get(), functions[i]);
+        }
+        found = std::move(worker.diagnostics);
+    };
+    
+    std::vector<std::vector<Diagnostic>> found(std::max<size_t>(workers, 1));
+    if (workers <= 1) {
+        work(found[0]);
+    } else {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> failures(workers);
+        for (size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w]() {
+                try {
+                    work(found[w]);
+                } catch (...) {
+                    failures[w] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& failure : failures) {
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+        }
+    }
+    
+    for (const auto& list : found) {
+        diagnostics.insert(diagnostics.end(), list.begin(), list.end());
+    }
+}
+
+bool TypeChecker::reuseFunction(const FunctionDeclaration* stmt, size_t index, size_t hash) {
+    // Redefinitions share a name with another function and are never cached
+    if (!stmt->getBinding().isResolved()) {
+        return false;
+    }
+    
+    auto it = cache->entries.find(stmt->getName());
+    if (it == cache->entries.end()) {
+        return false;
+    }
+    const CheckCache::Entry& entry = it->second;
+    if (entry.hash != hash || entry.types.size() != static_cast<size_t>(stmt->getExpressionCount())) {
+        return false;
+    }
+    for (const auto& dependency : entry.dependencies) {
+        if (fingerprint(dependency.name) != dependency.fingerprint) {
+            return false;
+        }
+    }
+    
+    // Expression types are primitives or pointers to them, whose references
+    // are the same in every TypeTable
+    std::copy(entry.types.begin(), entry.types.end(), typeTable->begin() + stmt->getFirstExpression());
+    for (Diagnostic diagnostic : entry.diagnostics) {
+        diagnostic.statement = static_cast<uint32_t>(index);
+        diagnostics.push_back(diagnostic);
+    }
+    cache->reused++;
+    return true;
+}
+
+void TypeChecker::storeFunction(const FunctionDeclaration* stmt, size_t index, size_t hash) {
+    if (!stmt->getBinding().isResolved()) {
+        return;
+    }
+    
+    CheckCache::Entry& entry = cache->entries[stmt->getName()];
+    entry = CheckCache::Entry();
+    entry.hash = hash;
+    
+    auto first = typeTable->begin() + stmt->getFirstExpression();
+    entry.types.assign(first, first + stmt->getExpressionCount());
+    
+    // Diagnostics are sorted by statement; their names must outlive this AST
+    uint32_t statement = static_cast<uint32_t>(index);
+    auto begin = std::lower_bound(diagnostics.begin(), diagnostics.end(), statement,
+                                  [](const Diagnostic& d, uint32_t s) { return d.statement < s; });
+    auto end = std::upper_bound(begin, diagnostics.end(), statement,
+                                [](uint32_t s, const Diagnostic& d) { return s < d.statement; });
+    entry.names.reserve(end - begin);
+    for (auto it = begin; it != end; ++it) {
+        Diagnostic diagnostic = *it;
+        entry.names.emplace_back(diagnostic.name);
+        diagnostic.name = entry.names.back();
+        entry.diagnostics.push_back(diagnostic);
+    }
+    
+    std::vector<std::string_view>& names = functionDependencies[index];
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    for (std::string_view name : names) {
+        entry.dependencies.push_back({std::string(name), fingerprint(name)});
+    }
+}
+
+size_t TypeChecker::fingerprint(std::string_view name) const {
+    Binding binding = binder.resolveGlobal(name);
+    if (!binding.isResolved()) {
+        return 0;
+    }
+    const Symbol& symbol = binder.getSymbol(binding);
+    return std::hash<std::string>()(types.name(symbol.type)) * 31 + static_cast<size_t>(symbol.kind) + 1;
+}
+
+// Locals count too: a global declared under the same name later changes
+// how they bind
+void TypeChecker::recordDependency(std::string_view name) {
+    if (dependencyTable && inFunctionBody) {
+        (*dependencyTable)[currentStatement].push_back(name);
+    }
+}
+
+TypeRef TypeChecker::checkExpression(const Expression* expr) {
+    TypeRef type;
+    if (auto* literalExpr = dynamic_cast<const LiteralExpression*>(expr)) {
+        type = checkLiteral(literalExpr);
+    } else if (auto* identifierExpr = dynamic_cast<const IdentifierExpression*>(expr)) {
+        type = checkIdentifier(identifierExpr);
+    } else if (auto* unaryExpr = dynamic_cast<const UnaryExpression*>(expr)) {
+        type = checkUnary(unaryExpr);
+    } else if (auto* binaryExpr = dynamic_cast<const BinaryExpression*>(expr)) {
+        type = checkBinary(binaryExpr);
+    } else if (auto* logicalExpr = dynamic_cast<const LogicalExpression*>(expr)) {
+        type = checkLogical(logicalExpr);
+    } else if (auto* assignExpr = dynamic_cast<const AssignExpression*>(expr)) {
+        type = checkAssign(assignExpr);
+    } else if (auto* callExpr = dynamic_cast<const CallExpression*>(expr)) {
+        type = checkCall(callExpr);
+    } else {
+        return report({DiagnosticKind::UNKNOWN_EXPRESSION});
+    }
+    
+    // Record the type so later phases need not infer it again
+    ExpressionType& entry = (*typeTable)[expr->getId()];
+    entry.type = type;
+    entry.converted = type;
+    return type;
+}
+
+TypeRef TypeChecker::checkLiteral(const LiteralExpression* expr) {
+    return primitiveType(typeIdOf(expr->getLiteralType()));
+}
+
+TypeRef TypeChecker::checkIdentifier(const IdentifierExpression* expr) {
+    recordDependency(expr->getName());
+    
+    if (!expr->getBinding().isResolved()) {
+        Diagnostic diagnostic{DiagnosticKind::UNDEFINED_VARIABLE};
+        diagnostic.name = expr->getName();
+        return report(diagnostic);
+    }
+    
+    const Symbol* symbol = &binder.getSymbol(expr->getBinding());
+    if (symbol->kind == Symbol::SymbolKind::FUNCTION) {
+        Diagnostic diagnostic{DiagnosticKind::FUNCTION_AS_VARIABLE};
+        diagnostic.name = expr->getName();
+        return report(diagnostic);
+    }
+    
+    return symbol->type;
+}
+
+TypeRef TypeChecker::checkUnary(const UnaryExpression* expr) {
+    TypeRef rightType = checkExpression(expr->getOperand());
+    TokenType op = expr->getOperator();
+    
+    // Errors in the operand have already been reported
+    if (rightType == ERROR_TYPE) {
+        return ERROR_TYPE;
+    }
+    
+    switch (op) {
+        case TokenType::MINUS:
+        case TokenType::PLUS:
+            if (!isNumericType(types.kindOf(rightType))) {
+                return report({DiagnosticKind::UNARY_NOT_NUMERIC});
+            }
+            return rightType;
+        
+        case TokenType::NOT:
+            return primitiveType(TypeId::BOOL);
+        
+        case TokenType::INCREMENT:
+        case TokenType::DECREMENT:
+            if (!isNumericType(types.kindOf(rightType))) {
+                return report({DiagnosticKind::INCREMENT_NOT_NUMERIC});
+            }
+            return rightType;
+        
+        case TokenType::MULTIPLY: // Dereference operator
+            // The untyped pointer has no known pointee
+            if (types.kindOf(rightType) != TypeId::POINTER || types.pointee(rightType) == ERROR_TYPE) {
+                return report({DiagnosticKind::DEREFERENCE_NON_POINTER});
+            }
+            return types.pointee(rightType);
+        
+        case TokenType::AMPERSAND: // Address-of operator
+            // Return pointer to the type
+            return types.findPointerTo(rightType);
+        
+        default: {
+            Diagnostic diagnostic{DiagnosticKind::UNSUPPORTED_UNARY};
+            diagnostic.op = op;
+            return report(diagnostic);
+        }
+    }
+}
+
+TypeRef TypeChecker::checkBinary(const BinaryExpression* expr) {
+    TypeRef leftType = checkExpression(expr->getLeft());
+    TypeRef rightType = checkExpression(expr->getRight());
+    TokenType op = expr->getOperator();
+    
+    if (leftType == ERROR_TYPE || rightType == ERROR_TYPE) {
+        return ERROR_TYPE;
+    }
+    
+    // Stream operators yield their left operand; in a real compiler, we'd
+    // verify these are actually stream objects
+    TypeId resultKind = resultTypeOf(op, types.kindOf(leftType), types.kindOf(rightType));
+    if (resultKind == TypeId::ERROR) {
+        Diagnostic diagnostic{DiagnosticKind::UNSUPPORTED_BINARY};
+        switch (operatorClassOf(op)) {
+            case OperatorClass::ADD:
+            case OperatorClass::SUBTRACT:
+            case OperatorClass::MULTIPLY:
+                diagnostic.kind = DiagnosticKind::BINARY_NOT_NUMERIC;
+                break;
+            case OperatorClass::COMPARE:
+                diagnostic.kind = DiagnosticKind::INCOMPATIBLE_COMPARISON;
+                break;
+            default:
+                break;
+        }
+        diagnostic.expected = leftType;
+        diagnostic.actual = rightType;
+        diagnostic.op = op;
+        return report(diagnostic);
+    }
+    
+    // The integer operand of mixed arithmetic or comparison is promoted
+    TypeId operandType = promotedType(types.kindOf(leftType), types.kindOf(rightType));
+    if (operandType != TypeId::ERROR && operatorClassOf(op) != OperatorClass::STREAM) {
+        recordConversion(expr->getLeft(), primitiveType(operandType));
+        recordConversion(expr->getRight(), primitiveType(operandType));
+    }
+    
+    // Pointer arithmetic keeps the exact pointer type; streams yield their left operand
+    if (resultKind == TypeId::POINTER) {
+        return types.kindOf(leftType) == TypeId::POINTER ? leftType : rightType;
+    }
+    if (operatorClassOf(op) == OperatorClass::STREAM) {
+        return leftType;
+    }
+    return primitiveType(resultKind);
+}
+
+TypeRef TypeChecker::checkLogical(const LogicalExpression* expr) {
+    TypeRef leftType = checkExpression(expr->getLeft());
+    TypeRef rightType = checkExpression(expr->getRight());
+    
+    if (leftType != ERROR_TYPE && !isBooleanType(types.kindOf(leftType))) {
+        Diagnostic diagnostic{DiagnosticKind::LOGICAL_LEFT_NOT_BOOLEAN};
+        diagnostic.actual = leftType;
+        report(diagnostic);
+    }
+    
+    if (rightType != ERROR_TYPE && !isBooleanType(types.kindOf(rightType))) {
+        Diagnostic diagnostic{DiagnosticKind::LOGICAL_RIGHT_NOT_BOOLEAN};
+        diagnostic.actual = rightType;
+        report(diagnostic);
+    }
+    
+    // The result is boolean whatever the operands were
+    return primitiveType(TypeId::BOOL);
+}
+
+TypeRef TypeChecker::checkAssign(const AssignExpression* expr) {
+    TypeRef rightType = checkExpression(expr->getValue());
+    
+    recordDependency(expr->getName());
+    if (!expr->getBinding().isResolved()) {
+        Diagnostic diagnostic{DiagnosticKind::ASSIGN_UNDECLARED};
+        diagnostic.name = expr->getName();
+        return report(diagnostic);
+    }
+    
+    const Symbol* symbol = &binder.getSymbol(expr->getBinding());
+    if (symbol->kind == Symbol::SymbolKind::FUNCTION) {
+        Diagnostic diagnostic{DiagnosticKind::ASSIGN_TO_FUNCTION};
+        diagnostic.name = expr->getName();
+        return report(diagnostic);
+    }
+    
+    // The variable keeps its type even if the value is ill-typed
+    TypeRef leftType = symbol->type;
+    if (rightType == ERROR_TYPE) {
+        return leftType;
+    }
+    
+    // Be more strict about type compatibility
+    if (!types.isAssignable(leftType, rightType)) {
+        Diagnostic diagnostic{DiagnosticKind::ASSIGN_MISMATCH};
+        diagnostic.expected = leftType;
+        diagnostic.actual = rightType;
+        report(diagnostic);
+        return leftType;
+    }
+    
+    recordConversion(expr->getValue(), leftType);
+    return leftType;
+}
+
+TypeRef TypeChecker::checkCall(const CallExpression* expr) {
+    const auto& args = expr->getArguments();
+    recordDependency(expr->getCallee());
+    
+    if (!expr->getBinding().isResolved() ||
+        binder.getSymbol(expr->getBinding()).kind != Symbol::SymbolKind::FUNCTION) {
+        // Still check the arguments for errors of their own
+        for (const auto& arg : args) {
+            checkExpression(arg.get());
+        }
+        Diagnostic diagnostic{expr->getBinding().isResolved() ? DiagnosticKind::NOT_A_FUNCTION
+                                                              : DiagnosticKind::UNDEFINED_FUNCTION};
+        diagnostic.name = expr->getCallee();
+        return report(diagnostic);
+    }
+    
+    const Symbol* symbol = &binder.getSymbol(expr->getBinding());
+    TypeRef signature = symbol->type;
+    TypeRef returnType = types.returnType(signature);
+    
+    if (types.parameterCount(signature) != args.size()) {
+        for (const auto& arg : args) {
+            checkExpression(arg.get());
+        }
+        Diagnostic diagnostic{DiagnosticKind::ARGUMENT_COUNT};
+        diagnostic.name = expr->getCallee();
+        diagnostic.argument = types.parameterCount(signature);
+        diagnostic.count = static_cast<uint32_t>(args.size());
+        report(diagnostic);
+        return returnType;
+    }
+    
+    for (size_t i = 0; i < args.size(); ++i) {
+        TypeRef argType = checkExpression(args[i].get());
+        TypeRef paramType = types.parameterType(signature, i);
+        if (argType == ERROR_TYPE) {
+            continue;
+        }
+        
+        // Be more strict about argument types
+        if (!types.isAssignable(paramType, argType)) {
+            Diagnostic diagnostic{DiagnosticKind::ARGUMENT_MISMATCH};
+            diagnostic.name = expr->getCallee();
+            diagnostic.argument = static_cast<uint32_t>(i + 1);
+            diagnostic.expected = paramType;
+            diagnostic.actual = argType;
+            report(diagnostic);
+            continue;
+        }
+        recordConversion(args[i].get(), paramType);
+    }
+    
+    return returnType;
+}
+
+void TypeChecker::checkStatement(const Statement* stmt) {
+    if (auto* exprStmt = dynamic_cast<const ExpressionStatement*>(stmt)) {
+        checkExpressionStatement(exprStmt);
+    } else if (auto* blockStmt = dynamic_cast<const BlockStatement*>(stmt)) {
+        checkBlock(blockStmt);
+    } else if (auto* varDecl = dynamic_cast<const VariableDeclaration*>(stmt)) {
+        checkVariableDeclaration(varDecl);
+    } else if (auto* funcDecl = dynamic_cast<const FunctionDeclaration*>(stmt)) {
+        checkFunctionDeclaration(funcDecl);
+    } else if (auto* ifStmt = dynamic_cast<const IfStatement*>(stmt)) {
+        checkIfStatement(ifStmt);
+    } else if (auto* whileStmt = dynamic_cast<const WhileStatement*>(stmt)) {
+        checkWhileStatement(whileStmt);
+    } else if (auto* forStmt = dynamic_cast<const ForStatement*>(stmt)) {
+        checkForStatement(forStmt);
+    } else if (auto* returnStmt = dynamic_cast<const ReturnStatement*>(stmt)) {
+        checkReturnStatement(returnStmt);
+    } else {
+        report({DiagnosticKind::UNKNOWN_STATEMENT});
+    }
+}
+
+void TypeChecker::checkExpressionStatement(const ExpressionStatement* stmt) {
+    checkExpression(stmt->getExpression());
+}
+
+void TypeChecker::checkBlock(const BlockStatement* stmt) {
+    for (const auto& statement : stmt->getStatements()) {
+        checkStatement(statement.get());
+    }
+}
+
+void TypeChecker::checkVariableDeclaration(const VariableDeclaration* stmt) {
+    // Redefinitions have no symbol; the pointer to every primitive type is always interned
+    TypeRef type = primitiveType(typeIdOf(stmt->getType()));
+    if (stmt->getBinding().isResolved()) {
+        type = binder.getSymbol(stmt->getBinding()).type;
+    } else if (stmt->getIsPointer()) {
+        type = types.findPointerTo(type);
+    }
+    
+    // The Binder leaves a declaration unbound if the name was already visible
+    recordDependency(stmt->getName());
+    if (!stmt->getBinding().isResolved()) {
+        Diagnostic diagnostic{DiagnosticKind::VARIABLE_REDEFINED};
+        diagnostic.name = stmt->getName();
+        report(diagnostic);
+    }
+    
+    // Check initializer if present
+    if (const Expression* initializer = stmt->getInitializer()) {
+        TypeRef initType = checkExpression(initializer);
+        if (initType == ERROR_TYPE) {
+            return;
+        }
+        
+        // Allow compatible types
+        if (!types.isCompatible(type, initType)) {
+            Diagnostic diagnostic{DiagnosticKind::INITIALIZER_MISMATCH};
+            diagnostic.expected = type;
+            diagnostic.actual = initType;
+            report(diagnostic);
+            return;
+        }
+        recordConversion(initializer, type);
+    }
+}
+
+void TypeChecker::checkFunctionDeclaration(const FunctionDeclaration* stmt) {
+    // Functions the Binder could not register are redefinitions
+    if (!stmt->getBinding().isResolved()) {
+        Diagnostic diagnostic{DiagnosticKind::FUNCTION_REDEFINED};
+        diagnostic.name = stmt->getName();
+        report(diagnostic);
+    }
+    
+    // Set current function for return checking
+    std::string_view previousFunction = currentFunctionName;
+    TokenType previousReturnType = currentFunctionReturnType;
+    bool previousInFunction = inFunctionBody;
+    
+    currentFunctionName = stmt->getName();
+    currentFunctionReturnType = stmt->getReturnType();
+    inFunctionBody = true;
+    
+    // Check function body; parameters were bound by the Binder
+    for (const auto& param : stmt->getParameters()) {
+        recordDependency(param.name);
+    }
+    checkStatement(stmt->getBody());
+    
+    // Restore previous function context
+    currentFunctionName = previousFunction;
+    currentFunctionReturnType = previousReturnType;
+    inFunctionBody = previousInFunction;
+}
+
+void TypeChecker::checkIfStatement(const IfStatement* stmt) {
+    // Check condition
+    TypeRef condType = checkExpression(stmt->getCondition());
+    if (condType != ERROR_TYPE && !isBooleanType(types.kindOf(condType))) {
+        Diagnostic diagnostic{DiagnosticKind::IF_CONDITION};
+        diagnostic.actual = condType;
+        report(diagnostic);
+    }
+    
+    // Check then branch
+    checkStatement(stmt->getThenBranch());
+    
+    // Check else branch if present
+    if (stmt->getElseBranch()) {
+        checkStatement(stmt->getElseBranch());
+    }
+}
+
+void TypeChecker::checkWhileStatement(const WhileStatement* stmt) {
+    // Check condition
+    TypeRef condType = checkExpression(stmt->getCondition());
+    if (condType != ERROR_TYPE && !isBooleanType(types.kindOf(condType))) {
+        Diagnostic diagnostic{DiagnosticKind::WHILE_CONDITION};
+        diagnostic.actual = condType;
+        report(diagnostic);
+    }
+    
+    // Check body
+    checkStatement(stmt->getBody());
+}
+
+void TypeChecker::checkForStatement(const ForStatement* stmt) {
+    // Check initializer if present
+    if (stmt->getInitializer()) {
+        checkStatement(stmt->getInitializer());
+    }
+    
+    // Check condition if present
+    if (stmt->getCondition()) {
+        TypeRef condType = checkExpression(stmt->getCondition());
+        if (condType != ERROR_TYPE && !isBooleanType(types.kindOf(condType))) {
+            Diagnostic diagnostic{DiagnosticKind::FOR_CONDITION};
+            diagnostic.actual = condType;
+            report(diagnostic);
+        }
+    }
+    
+    // Check increment if present
+    if (stmt->getIncrement()) {
+        checkExpression(stmt->getIncrement());
+    }
+    
+    // Check body
+    checkStatement(stmt->getBody());
+}
+
+void TypeChecker::checkReturnStatement(const ReturnStatement* stmt) {
+    if (!inFunctionBody) {
+        report({DiagnosticKind::RETURN_OUTSIDE_FUNCTION});
+        return;
+    }
+    
+    TypeRef expectedType = primitiveType(typeIdOf(currentFunctionReturnType));
+    
+    // Check return value if present
+    if (stmt->getValue()) {
+        TypeRef returnType = checkExpression(stmt->getValue());
+        
+        if (currentFunctionReturnType == TokenType::VOID) {
+            report({DiagnosticKind::RETURN_FROM_VOID});
+            return;
+        }
+        if (returnType == ERROR_TYPE) {
+            return;
+        }
+        
+        if (!types.isCompatible(expectedType, returnType)) {
+            Diagnostic diagnostic{DiagnosticKind::RETURN_MISMATCH};
+            diagnostic.name = currentFunctionName;
+            diagnostic.expected = expectedType;
+            diagnostic.actual = returnType;
+            report(diagnostic);
+            return;
+        }
+        recordConversion(stmt->getValue(), expectedType);
+    } else {
+        // No return value
+        if (currentFunctionReturnType != TokenType::VOID) {
+            Diagnostic diagnostic{DiagnosticKind::MISSING_RETURN_VALUE};
+            diagnostic.name = currentFunctionName;
+            diagnostic.expected = expectedType;
+            report(diagnostic);
+        }
+    }
+}
+
+void TypeChecker::recordConversion(const Expression* expr, TypeRef target) {
+    ExpressionType& entry = (*typeTable)[expr->getId()];
+    if (conversionOf(types.kindOf(entry.type), types.kindOf(target)) != Conversion::NONE) {
+        entry.converted = target;
+    }
+}
+
+TypeRef TypeChecker::report(Diagnostic diagnostic) {
+    diagnostic.statement = currentStatement;
+    diagnostics.push_back(diagnostic);
+    return ERROR_TYPE;
+}
+
+const char* TypeChecker::operatorSpelling(TokenType op) {
+    switch (op) {
+        case TokenType::PLUS: return "+";
+        case TokenType::MINUS: return "-";
+        case TokenType::MULTIPLY: return "*";
+        case TokenType::SLASH: return "/";
+        default: return "unknown";
+    }
+}
+
+std::string TypeChecker::formatDiagnostic(const Diagnostic& d) const {
+    std::stringstream ss;
+    switch (d.kind) {
+        case DiagnosticKind::FUNCTION_REDEFINED:
+            ss << "Function '" << d.name << "' already defined";
+            break;
+        case DiagnosticKind::VARIABLE_REDEFINED:
+            ss << "Variable '" << d.name << "' already defined";
+            break;
+        case DiagnosticKind::UNDEFINED_VARIABLE:
+            ss << "Undefined variable '" << d.name << "'";
+            break;
+        case DiagnosticKind::FUNCTION_AS_VARIABLE:
+            ss << "'" << d.name << "' is a function and cannot be used as a variable";
+            break;
+        case DiagnosticKind::UNARY_NOT_NUMERIC:
+            ss << "Unary '+' and '-' operators require numeric operands";
+            break;
+        case DiagnosticKind::INCREMENT_NOT_NUMERIC:
+            ss << "Increment and decrement operators require numeric operands";
+            break;
+        case DiagnosticKind::DEREFERENCE_NON_POINTER:
+            ss << "Cannot dereference non-pointer type";
+            break;
+        case DiagnosticKind::UNSUPPORTED_UNARY:
+            ss << "Unsupported unary operator: " << static_cast<int>(d.op);
+            break;
+        case DiagnosticKind::BINARY_NOT_NUMERIC:
+            ss << "Binary operator '" << operatorSpelling(d.op)
+               << "' requires numeric operands, got "
+               << types.name(d.expected) << " and " << types.name(d.actual);
+            break;
+        case DiagnosticKind::INCOMPATIBLE_COMPARISON:
+            ss << "Cannot compare incompatible types: "
+               << types.name(d.expected) << " and " << types.name(d.actual);
+            break;
+        case DiagnosticKind::UNSUPPORTED_BINARY:
+            ss << "Unsupported binary operator: " << static_cast<int>(d.op);
+            break;
+        case DiagnosticKind::LOGICAL_LEFT_NOT_BOOLEAN:
+            ss << "Left operand of logical operator must be boolean, got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::LOGICAL_RIGHT_NOT_BOOLEAN:
+            ss << "Right operand of logical operator must be boolean, got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::ASSIGN_UNDECLARED:
+            ss << "Cannot assign to undeclared variable '" << d.name << "'";
+            break;
+        case DiagnosticKind::ASSIGN_TO_FUNCTION:
+            ss << "Cannot assign to function '" << d.name << "'";
+            break;
+        case DiagnosticKind::ASSIGN_MISMATCH:
+            ss << "Cannot assign " << types.name(d.actual)
+               << " to variable of type " << types.name(d.expected);
+            break;
+        case DiagnosticKind::UNDEFINED_FUNCTION:
+            ss << "Undefined function '" << d.name << "'";
+            break;
+        case DiagnosticKind::NOT_A_FUNCTION:
+            ss << "'" << d.name << "' is not a function";
+            break;
+        case DiagnosticKind::ARGUMENT_COUNT:
+            ss << "Function '" << d.name << "' expects "
+               << d.argument << " arguments, but got " << d.count;
+            break;
+        case DiagnosticKind::ARGUMENT_MISMATCH:
+            ss << "Argument " << d.argument << " to function '" << d.name
+               << "' has incompatible type: expected " << types.name(d.expected)
+               << ", got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::INITIALIZER_MISMATCH:
+            ss << "Cannot initialize variable of type " << types.name(d.expected)
+               << " with value of type " << types.name(d.actual);
+            break;
+        case DiagnosticKind::IF_CONDITION:
+            ss << "If condition must be boolean, got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::WHILE_CONDITION:
+            ss << "While condition must be boolean, got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::FOR_CONDITION:
+            ss << "For loop condition must be boolean, got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::RETURN_OUTSIDE_FUNCTION:
+            ss << "Return statement outside of function body";
+            break;
+        case DiagnosticKind::RETURN_FROM_VOID:
+            ss << "Cannot return a value from void function";
+            break;
+        case DiagnosticKind::RETURN_MISMATCH:
+            ss << "Function '" << d.name << "' returns " << types.name(d.expected)
+               << " but got " << types.name(d.actual);
+            break;
+        case DiagnosticKind::MISSING_RETURN_VALUE:
+            ss << "Function '" << d.name << "' must return a value of type " << types.name(d.expected);
+            break;
+        case DiagnosticKind::UNKNOWN_EXPRESSION:
+            ss << "Unknown expression type";
+            break;
+        case DiagnosticKind::UNKNOWN_STATEMENT:
+            ss << "Unknown statement type";
+            break;
+    }
+    return ss.str();
+}
\ No newline at end of file
@@ -1,57 +1,184 @@
-// typechecker.h
-#pragma once
-#include "ast.h"
-#include "symboltable.h"
-#include <string>
-#include <memory>
-#include <vector>
-#include <stdexcept>
-
-// Custom exception for type errors
-class TypeError : public std::runtime_error {
-public:
-    explicit TypeError(const std::string& message) : std::runtime_error(message) {}
-};
-
-class TypeChecker {
-private:
-    SymbolTable symbolTable;
-    
-    // Current function return type for checking return statements
-    TokenType currentFunctionReturnType;
-    bool inFunctionBody;
-    std::string currentFunctionName;
-    
-    // Type checking methods for expressions
-    TokenType checkExpression(const Expression* expr);
-    TokenType checkLiteral(const LiteralExpression* expr);
-    TokenType checkIdentifier(const IdentifierExpression* expr);
-    TokenType checkUnary(const UnaryExpression* expr);
-    TokenType checkBinary(const BinaryExpression* expr);
-    TokenType checkLogical(const LogicalExpression* expr);
-    TokenType checkAssign(const AssignExpression* expr);
-    TokenType checkCall(const CallExpression* expr);
-    
-    // Type checking methods for statements
-    void checkStatement(const Statement* stmt);
-    void checkExpressionStatement(const ExpressionStatement* stmt);
-    void checkBlock(const BlockStatement* stmt);
-    void checkVariableDeclaration(const VariableDeclaration* stmt);
-    void checkFunctionDeclaration(const FunctionDeclaration* stmt);
-    void checkIfStatement(const IfStatement* stmt);
-    void checkWhileStatement(const WhileStatement* stmt);
-    void checkForStatement(const ForStatement* stmt);
-    void checkReturnStatement(const ReturnStatement* stmt);
-    
-    // Utility methods
-    bool isNumericType(TokenType type) const;
-    bool isBooleanType(TokenType type) const;
-    bool isPointerType(TokenType type) const;
-    bool isCompatibleType(TokenType left, TokenType right) const;
-    TokenType getResultType(TokenType left, TokenType op, TokenType right) const;
-    std::string tokenTypeToString(TokenType type) const;
-    
-public:
-    TypeChecker();
-    void check(const std::vector<std::unique_ptr<Statement>>& statements);
+// typechecker.h
+#pragma once
+#include "ast.h"
+#include "binder.h"
+#include "types.h"
+#include <string>
+#include <string_view>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstdint>
+
+// Custom exception for type errors
+class TypeError : public std::runtime_error {
+public:
+    explicit TypeError(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Resolved type of an expression, and the type it is implicitly converted to
+// where it is used (equal to type when it is used as is)
+struct ExpressionType {
+    TypeRef type = ERROR_TYPE;
+    TypeRef converted = ERROR_TYPE;
+};
+
+// Kinds of semantic error. The message for each is only formatted when the
+// diagnostics are reported.
+enum class DiagnosticKind : uint8_t {
+    FUNCTION_REDEFINED,
+    VARIABLE_REDEFINED,
+    UNDEFINED_VARIABLE,
+    FUNCTION_AS_VARIABLE,
+    UNARY_NOT_NUMERIC,
+    INCREMENT_NOT_NUMERIC,
+    DEREFERENCE_NON_POINTER,
+    UNSUPPORTED_UNARY,
+    BINARY_NOT_NUMERIC,
+    INCOMPATIBLE_COMPARISON,
+    UNSUPPORTED_BINARY,
+    LOGICAL_LEFT_NOT_BOOLEAN,
+    LOGICAL_RIGHT_NOT_BOOLEAN,
+    ASSIGN_UNDECLARED,
+    ASSIGN_TO_FUNCTION,
+    ASSIGN_MISMATCH,
+    UNDEFINED_FUNCTION,
+    NOT_A_FUNCTION,
+    ARGUMENT_COUNT,
+    ARGUMENT_MISMATCH,
+    INITIALIZER_MISMATCH,
+    IF_CONDITION,
+    WHILE_CONDITION,
+    FOR_CONDITION,
+    RETURN_OUTSIDE_FUNCTION,
+    RETURN_FROM_VOID,
+    RETURN_MISMATCH,
+    MISSING_RETURN_VALUE,
+    UNKNOWN_EXPRESSION,
+    UNKNOWN_STATEMENT
+};
+
+// A semantic error with just the facts needed to describe it. Names point into the AST.
+struct Diagnostic {
+    DiagnosticKind kind;
+    TypeRef expected = ERROR_TYPE;
+    TypeRef actual = ERROR_TYPE;
+    TokenType op = TokenType::END_OF_FILE;
+    uint32_t statement = 0;   // Top-level statement it was found in, for source ordering
+    uint32_t argument = 0;    // Argument position or expected argument count
+    uint32_t count = 0;       // Actual argument count
+    std::string_view name = {};
+};
+
+// Results of checking each function, kept between runs in watch mode. An
+// entry is reused while the function's text is unchanged and every name it
+// declares or refers to still has the same kind and type as a global, or is
+// still not a global.
+class CheckCache {
+private:
+    friend class TypeChecker;
+
+    struct Dependency {
+        std::string name;
+        size_t fingerprint;   // Kind and type of the global, 0 if undefined
+    };
+
+    struct Entry {
+        size_t hash = 0;                        // Signature and body
+        std::vector<Dependency> dependencies;
+        std::vector<ExpressionType> types;      // Indexed from the function's first expression
+        std::vector<Diagnostic> diagnostics;    // Names point into names below
+        std::vector<std::string> names;
+    };
+
+    std::unordered_map<std::string, Entry> entries;
+    size_t reused = 0;
+    size_t checked = 0;
+
+public:
+    // Statistics of the last run
+    size_t getReusedCount() const { return reused; }
+    size_t getCheckedCount() const { return checked; }
+};
+
+class TypeChecker {
+private:
+    const Binder& binder;
+    const TypeTable& types;
+    
+    // Expression types indexed by Expression::getId(); workers share the owner's table
+    std::vector<ExpressionType> expressionTypes;
+    std::vector<ExpressionType>* typeTable;
+    
+    // Names each function declares or refers to, indexed by statement; only
+    // collected when a cache is attached
+    CheckCache* cache;
+    std::vector<std::vector<std::string_view>> functionDependencies;
+    std::vector<std::vector<std::string_view>>* dependencyTable;
+    
+    // Current function return type for checking return statements
+    TokenType currentFunctionReturnType;
+    bool inFunctionBody;
+    std::string_view currentFunctionName;
+    
+    // Errors found so far. Checking continues past an error; expressions that
+    // fail get ERROR_TYPE, which later checks accept silently so one mistake
+    // is reported once.
+    std::vector<Diagnostic> diagnostics;
+    uint32_t currentStatement;
+    static constexpr size_t INITIAL_DIAGNOSTIC_CAPACITY = 64;
+    
+    // Function bodies are only split across threads when each worker gets at least this many
+    static constexpr size_t MIN_FUNCTIONS_PER_WORKER = 16;
+    
+    // Top-level checking
+    void checkTopLevel(const Statement* stmt, size_t index);
+    void checkFunctions(const std::vector<std::unique_ptr<Statement>>& statements,
+                        const std::vector<size_t>& functions);
+    
+    // Incremental checking
+    bool reuseFunction(const FunctionDeclaration* stmt, size_t index, size_t hash);
+    void storeFunction(const FunctionDeclaration* stmt, size_t index, size_t hash);
+    size_t fingerprint(std::string_view name) const;
+    void recordDependency(std::string_view name);
+    
+    // Type checking methods for expressions
+    TypeRef checkExpression(const Expression* expr);
+    TypeRef checkLiteral(const LiteralExpression* expr);
+    TypeRef checkIdentifier(const IdentifierExpression* expr);
+    TypeRef checkUnary(const UnaryExpression* expr);
+    TypeRef checkBinary(const BinaryExpression* expr);
+    TypeRef checkLogical(const LogicalExpression* expr);
+    TypeRef checkAssign(const AssignExpression* expr);
+    TypeRef checkCall(const CallExpression* expr);
+    
+    // Type checking methods for statements
+    void checkStatement(const Statement* stmt);
+    void checkExpressionStatement(const ExpressionStatement* stmt);
+    void checkBlock(const BlockStatement* stmt);
+    void checkVariableDeclaration(const VariableDeclaration* stmt);
+    void checkFunctionDeclaration(const FunctionDeclaration* stmt);
+    void checkIfStatement(const IfStatement* stmt);
+    void checkWhileStatement(const WhileStatement* stmt);
+    void checkForStatement(const ForStatement* stmt);
+    void checkReturnStatement(const ReturnStatement* stmt);
+    
+    // Utility methods; type rules live in the tables in types.h
+    void recordConversion(const Expression* expr, TypeRef target);
+    TypeRef report(Diagnostic diagnostic);
+    static const char* operatorSpelling(TokenType op);
+    std::string formatDiagnostic(const Diagnostic& diagnostic) const;
+    
+public:
+    TypeChecker(const Binder& binder);
+    
+    // Checks every statement, then throws a TypeError listing all errors found
+    void check(const std::vector<std::unique_ptr<Statement>>& statements);
+    
+    // Reuse and update per-function results across runs
+    void setCache(CheckCache* checkCache) { cache = checkCache; }
+    const std::vector<Diagnostic>& getDiagnostics() const { return diagnostics; }
+    const std::vector<ExpressionType>& getExpressionTypes() const { return expressionTypes; }
+    const ExpressionType& getExpressionType(const Expression* expr) const { return expressionTypes[expr->getId()]; }
 }; 
\ No newline at end of file
@@ -0,0 +1,234 @@
+// types.cpp
+#include "../include/types.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+TypeTable::TypeTable() {
+    // Primitive types take the references equal to their ids
+    for (size_t id = 0; id < TYPE_COUNT; ++id) {
+        add({static_cast<TypeId>(id), ERROR_TYPE, 0, 0});
+    }
+
+    // Declarations can only name pointers to primitive types
+    for (size_t id = 0; id < TYPE_COUNT; ++id) {
+        TypeId kind = static_cast<TypeId>(id);
+        if (kind != TypeId::ERROR && kind != TypeId::POINTER && kind != TypeId::FUNCTION) {
+            pointerTo(primitiveType(kind));
+        }
+    }
+}
+
+TypeRef TypeTable::add(const Type& type) {
+    types.push_back(type);
+    return static_cast<TypeRef>(types.size() - 1);
+}
+
+TypeRef TypeTable::pointerTo(TypeRef pointee) {
+    auto it = pointers.find(pointee);
+    if (it != pointers.end()) {
+        return it->second;
+    }
+    TypeRef pointer = add({TypeId::POINTER, pointee, 0, 0});
+    pointers.emplace(pointee, pointer);
+    return pointer;
+}
+
+TypeRef TypeTable::findPointerTo(TypeRef pointee) const {
+    auto it = pointers.find(pointee);
+    return it != pointers.end() ? it->second : primitiveType(TypeId::POINTER);
+}
+
+TypeRef TypeTable::function(TypeRef returnType, const std::vector<TypeRef>& parameters) {
+    size_t hash = returnType;
+    for (TypeRef param : parameters) {
+        hash = hash * 31 + param;
+    }
+    hash = hash * 31 + parameters.size();
+
+    // Reuse an identical signature if one exists
+    auto range = functions.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        const Type& candidate = types[it->second];
+        if (candidate.element != returnType || candidate.parameterCount != parameters.size()) {
+            continue;
+        }
+        bool same = true;
+        for (size_t i = 0; i < parameters.size() && same; ++i) {
+            same = parameterType(it->second, i) == parameters[i];
+        }
+        if (same) {
+            return it->second;
+        }
+    }
+
+    Type type{TypeId::FUNCTION, returnType,
+              static_cast<uint32_t>(parameterTypes.size()), static_cast<uint32_t>(parameters.size())};
+    parameterTypes.insert(parameterTypes.end(), parameters.begin(), parameters.end());
+
+    TypeRef function = add(type);
+    functions.emplace(hash, function);
+    return function;
+}
+
+TypeRef TypeTable::declared(TokenType type, bool isPointer) {
+    TypeRef base = primitiveType(typeIdOf(type));
+    return isPointer ? pointerTo(base) : base;
+}
+
+bool TypeTable::isCompatible(TypeRef left, TypeRef right) const {
+    if (!isCompatibleType(kindOf(left), kindOf(right))) {
+        return false;
+    }
+    // The untyped pointer matches any pointer
+    if (kindOf(left) == TypeId::POINTER && kindOf(right) == TypeId::POINTER) {
+        return left == right || pointee(left) == ERROR_TYPE || pointee(right) == ERROR_TYPE;
+    }
+    return true;
+}
+
+bool TypeTable::isAssignable(TypeRef target, TypeRef value) const {
+    if (!isAssignableType(kindOf(target), kindOf(value))) {
+        return false;
+    }
+    if (kindOf(target) == TypeId::POINTER) {
+        return target == value || pointee(target) == ERROR_TYPE || pointee(value) == ERROR_TYPE;
+    }
+    return true;
+}
+
+std::string TypeTable::name(TypeRef type) const {
+    const Type& t = types[type];
+    switch (t.kind) {
+        case TypeId::POINTER:
+            return t.element == ERROR_TYPE ? "pointer" : name(t.element) + "*";
+        case TypeId::FUNCTION: {
+            std::string result = name(t.element) + "(";
+            for (uint32_t i = 0; i < t.parameterCount; ++i) {
+                result += (i ? ", " : "") + name(parameterType(type, i));
+            }
+            return result + ")";
+        }
+        default:
+            return typeName(t.kind);
+    }
+}
+
+std::string Constant::toString() const {
+    switch (type) {
+        case TypeId::INT:
+            return std::to_string(integer);
+        case TypeId::FLOAT: {
+            // Shortest spelling that reads back as the same float
+            char buffer[32];
+            for (int precision = 6; precision <= 9; ++precision) {
+                std::snprintf(buffer, sizeof(buffer), "%.*g", precision, real);
+                if (std::strtof(buffer, nullptr) == real) {
+                    break;
+                }
+            }
+            std::string spelling = buffer;
+            if (spelling.find_first_of(".e") == std::string::npos) {
+                spelling += ".0";
+            }
+            return spelling;
+        }
+        case TypeId::BOOL:
+            return integer ? "true" : "false";
+        case TypeId::CHAR:
+            return std::string(1, static_cast<char>(integer));
+        case TypeId::STRING:
+            return text;
+        case TypeId::POINTER:
+            return integer ? std::to_string(integer) : "null";
+        default:
+            return "";
+    }
+}
+
+bool Constant::equals(const Constant& other) const {
+    // Floats compare by representation, so 0.0 and -0.0 stay apart
+    return type == other.type && integer == other.integer &&
+           std::memcmp(&real, &other.real, sizeof(real)) == 0 && text == other.text;
+}
+
+Constant convertConstant(Constant value, TypeId type) {
+    switch (conversionOf(value.type, type)) {
+        case Conversion::INT_TO_FLOAT:
+            value.type = TypeId::FLOAT;
+            value.real = static_cast<float>(value.integer);
+            break;
+        case Conversion::FLOAT_TO_INT:
+            // Out of range conversions are undefined; leave them to runtime
+            if (!(value.real > -2147483649.0f && value.real < 2147483648.0f)) {
+                return Constant();
+            }
+            value.type = TypeId::INT;
+            value.integer = static_cast<int32_t>(value.real);
+            value.real = 0.0f;
+            break;
+        default:
+            break;
+    }
+    return value;
+}
+
+Constant evaluateBinary(TokenType op, TypeId type, const Constant& l, const Constant& r) {
+    Constant value;
+    switch (operatorClassOf(op)) {
+        case OperatorClass::ADD:
+        case OperatorClass::SUBTRACT:
+        case OperatorClass::MULTIPLY:
+            if (type == TypeId::INT && l.type == TypeId::INT && r.type == TypeId::INT) {
+                int64_t a = l.integer;
+                int64_t b = r.integer;
+                // Division traps at runtime; leave it there
+                if (op == TokenType::SLASH && (b == 0 || (a == INT32_MIN && b == -1))) {
+                    break;
+                }
+                value.type = TypeId::INT;
+                value.integer = wrapInteger(op == TokenType::PLUS ? a + b :
+                                            op == TokenType::MINUS ? a - b :
+                                            op == TokenType::MULTIPLY ? a * b : a / b);
+            } else if (type == TypeId::FLOAT && l.type == TypeId::FLOAT && r.type == TypeId::FLOAT) {
+                float real = op == TokenType::PLUS ? l.real + r.real :
+                             op == TokenType::MINUS ? l.real - r.real :
+                             op == TokenType::MULTIPLY ? l.real * r.real : l.real / r.real;
+                if (std::isfinite(real)) {
+                    value.type = TypeId::FLOAT;
+                    value.real = real;
+                }
+            } else if (type == TypeId::STRING && op == TokenType::PLUS &&
+                       l.type == TypeId::STRING && r.type == TypeId::STRING) {
+                value.type = TypeId::STRING;
+                value.text = l.text + r.text;
+            }
+            break;
+
+        case OperatorClass::COMPARE: {
+            if (l.type != r.type || l.type == TypeId::STRING) {
+                break;
+            }
+            bool isFloat = l.type == TypeId::FLOAT;
+            int order = isFloat ? (l.real < r.real ? -1 : l.real > r.real ? 1 : 0)
+                                : (l.integer < r.integer ? -1 : l.integer > r.integer ? 1 : 0);
+            bool equal = isFloat ? l.real == r.real : l.integer == r.integer;
+            value.type = TypeId::BOOL;
+            switch (op) {
+                case TokenType::EQUAL_EQUAL: value.integer = equal; break;
+                case TokenType::NOT_EQUAL: value.integer = !equal; break;
+                case TokenType::LESS: value.integer = !equal && order < 0; break;
+                case TokenType::LESS_EQUAL: value.integer = equal || order < 0; break;
+                case TokenType::GREATER: value.integer = !equal && order > 0; break;
+                case TokenType::GREATER_EQUAL: value.integer = equal || order > 0; break;
+                default: value.type = TypeId::ERROR; break;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+    return value;
+}
\ No newline at end of file
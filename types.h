@@ -0,0 +1,302 @@
+// types.h
+#pragma once
+#include "token.hpp"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Compact type ids. The literal and declared forms of a type (INTEGER_LITERAL
+// and INT, BOOL_LITERAL and BOOL, ...) share one id.
+enum class TypeId : uint8_t {
+    ERROR,      // No valid type; result of an ill-typed operation
+    VOID,
+    BOOL,
+    CHAR,
+    INT,
+    FLOAT,
+    STRING,
+    POINTER,
+    FUNCTION,
+    COUNT
+};
+
+// Binary operators grouped by typing rule
+enum class OperatorClass : uint8_t {
+    NONE,       // Not a binary operator
+    ADD,        // +
+    SUBTRACT,   // -
+    MULTIPLY,   // * /
+    COMPARE,    // == != < <= > >=
+    LOGICAL,    // && ||
+    STREAM,     // << >>
+    COUNT
+};
+
+// Implicit conversion needed to use a value of one type as another
+enum class Conversion : uint8_t {
+    NONE,
+    INT_TO_FLOAT,
+    FLOAT_TO_INT
+};
+
+// The type rules below are built once at compile time into lookup tables, so
+// every query is an index into a constexpr array. The tables are shared by
+// the type checker, constant folding and code generation.
+
+constexpr size_t TYPE_COUNT = static_cast<size_t>(TypeId::COUNT);
+constexpr size_t OPERATOR_CLASS_COUNT = static_cast<size_t>(OperatorClass::COUNT);
+constexpr size_t TOKEN_TYPE_COUNT = static_cast<size_t>(TokenType::END_OF_FILE) + 1;
+
+using TypeRow = std::array<TypeId, TYPE_COUNT>;
+using TypeMatrix = std::array<TypeRow, TYPE_COUNT>;
+using FlagRow = std::array<bool, TYPE_COUNT>;
+using FlagMatrix = std::array<FlagRow, TYPE_COUNT>;
+
+constexpr size_t typeIndex(TypeId type) { return static_cast<size_t>(type); }
+constexpr size_t tokenIndex(TokenType type) { return static_cast<size_t>(type); }
+constexpr size_t operatorIndex(OperatorClass op) { return static_cast<size_t>(op); }
+
+constexpr std::array<TypeId, TOKEN_TYPE_COUNT> buildTokenTypeIds() {
+    std::array<TypeId, TOKEN_TYPE_COUNT> ids{};
+    ids[tokenIndex(TokenType::VOID)] = TypeId::VOID;
+    ids[tokenIndex(TokenType::BOOL)] = TypeId::BOOL;
+    ids[tokenIndex(TokenType::BOOL_LITERAL)] = TypeId::BOOL;
+    ids[tokenIndex(TokenType::TRUE)] = TypeId::BOOL;
+    ids[tokenIndex(TokenType::FALSE)] = TypeId::BOOL;
+    ids[tokenIndex(TokenType::CHAR)] = TypeId::CHAR;
+    ids[tokenIndex(TokenType::CHAR_LITERAL)] = TypeId::CHAR;
+    ids[tokenIndex(TokenType::INT)] = TypeId::INT;
+    ids[tokenIndex(TokenType::INTEGER_LITERAL)] = TypeId::INT;
+    ids[tokenIndex(TokenType::FLOAT)] = TypeId::FLOAT;
+    ids[tokenIndex(TokenType::FLOAT_LITERAL)] = TypeId::FLOAT;
+    ids[tokenIndex(TokenType::STRING_LITERAL)] = TypeId::STRING;
+    ids[tokenIndex(TokenType::POINTER)] = TypeId::POINTER;
+    return ids;
+}
+
+constexpr std::array<OperatorClass, TOKEN_TYPE_COUNT> buildOperatorClasses() {
+    std::array<OperatorClass, TOKEN_TYPE_COUNT> classes{};
+    classes[tokenIndex(TokenType::PLUS)] = OperatorClass::ADD;
+    classes[tokenIndex(TokenType::MINUS)] = OperatorClass::SUBTRACT;
+    classes[tokenIndex(TokenType::MULTIPLY)] = OperatorClass::MULTIPLY;
+    classes[tokenIndex(TokenType::SLASH)] = OperatorClass::MULTIPLY;
+    classes[tokenIndex(TokenType::EQUAL_EQUAL)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::NOT_EQUAL)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::LESS)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::LESS_EQUAL)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::GREATER)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::GREATER_EQUAL)] = OperatorClass::COMPARE;
+    classes[tokenIndex(TokenType::AND)] = OperatorClass::LOGICAL;
+    classes[tokenIndex(TokenType::OR)] = OperatorClass::LOGICAL;
+    classes[tokenIndex(TokenType::LEFT_SHIFT)] = OperatorClass::STREAM;
+    classes[tokenIndex(TokenType::RIGHT_SHIFT)] = OperatorClass::STREAM;
+    return classes;
+}
+
+constexpr FlagRow buildNumericTypes() {
+    FlagRow numeric{};
+    numeric[typeIndex(TypeId::INT)] = true;
+    numeric[typeIndex(TypeId::FLOAT)] = true;
+    return numeric;
+}
+
+inline constexpr auto TOKEN_TYPE_IDS = buildTokenTypeIds();
+inline constexpr auto OPERATOR_CLASSES = buildOperatorClasses();
+inline constexpr auto NUMERIC_TYPES = buildNumericTypes();
+
+// Common type of two numeric operands (float if either is float)
+constexpr TypeMatrix buildPromotions() {
+    TypeMatrix promoted{};
+    for (size_t l = 0; l < TYPE_COUNT; ++l) {
+        for (size_t r = 0; r < TYPE_COUNT; ++r) {
+            if (!NUMERIC_TYPES[l] || !NUMERIC_TYPES[r]) {
+                continue;
+            }
+            bool isFloat = l == typeIndex(TypeId::FLOAT) || r == typeIndex(TypeId::FLOAT);
+            promoted[l][r] = isFloat ? TypeId::FLOAT : TypeId::INT;
+        }
+    }
+    return promoted;
+}
+
+inline constexpr auto PROMOTIONS = buildPromotions();
+
+// Types that may be compared or used to initialize one another
+constexpr FlagMatrix buildCompatibility() {
+    FlagMatrix compatible{};
+    for (size_t l = 0; l < TYPE_COUNT; ++l) {
+        for (size_t r = 0; r < TYPE_COUNT; ++r) {
+            compatible[l][r] = (l == r && l != typeIndex(TypeId::ERROR)) ||
+                               PROMOTIONS[l][r] != TypeId::ERROR;
+        }
+    }
+    // Pointers accept integers (null)
+    compatible[typeIndex(TypeId::POINTER)][typeIndex(TypeId::INT)] = true;
+    return compatible;
+}
+
+// Value types that may be assigned or passed to a target type without a cast
+constexpr FlagMatrix buildAssignability() {
+    FlagMatrix assignable{};
+    for (size_t t = 0; t < TYPE_COUNT; ++t) {
+        assignable[t][t] = t != typeIndex(TypeId::ERROR);
+    }
+    assignable[typeIndex(TypeId::FLOAT)][typeIndex(TypeId::INT)] = true;
+    return assignable;
+}
+
+// Result type of each operator class for every operand pair, ERROR if ill-typed
+constexpr std::array<TypeMatrix, OPERATOR_CLASS_COUNT> buildResultTypes() {
+    constexpr size_t STRING = typeIndex(TypeId::STRING);
+    constexpr size_t POINTER = typeIndex(TypeId::POINTER);
+    constexpr size_t BOOL = typeIndex(TypeId::BOOL);
+    constexpr size_t ERROR = typeIndex(TypeId::ERROR);
+    constexpr FlagMatrix compatible = buildCompatibility();
+
+    std::array<TypeMatrix, OPERATOR_CLASS_COUNT> results{};
+    for (size_t l = 0; l < TYPE_COUNT; ++l) {
+        for (size_t r = 0; r < TYPE_COUNT; ++r) {
+            if (l == ERROR || r == ERROR) {
+                continue;
+            }
+            TypeId promoted = PROMOTIONS[l][r];
+
+            // String concatenation, then pointer arithmetic, then numbers
+            TypeId add = promoted;
+            if (l == STRING || r == STRING) {
+                add = TypeId::STRING;
+            } else if ((l == POINTER && NUMERIC_TYPES[r]) || (r == POINTER && NUMERIC_TYPES[l])) {
+                add = TypeId::POINTER;
+            }
+            results[operatorIndex(OperatorClass::ADD)][l][r] = add;
+            results[operatorIndex(OperatorClass::SUBTRACT)][l][r] =
+                (l == POINTER && NUMERIC_TYPES[r]) ? TypeId::POINTER : promoted;
+            results[operatorIndex(OperatorClass::MULTIPLY)][l][r] = promoted;
+            results[operatorIndex(OperatorClass::COMPARE)][l][r] =
+                compatible[l][r] ? TypeId::BOOL : TypeId::ERROR;
+            results[operatorIndex(OperatorClass::LOGICAL)][l][r] =
+                (l == BOOL && r == BOOL) ? TypeId::BOOL : TypeId::ERROR;
+            results[operatorIndex(OperatorClass::STREAM)][l][r] = static_cast<TypeId>(l);
+        }
+    }
+    return results;
+}
+
+constexpr std::array<std::array<Conversion, TYPE_COUNT>, TYPE_COUNT> buildConversions() {
+    std::array<std::array<Conversion, TYPE_COUNT>, TYPE_COUNT> conversions{};
+    conversions[typeIndex(TypeId::INT)][typeIndex(TypeId::FLOAT)] = Conversion::INT_TO_FLOAT;
+    conversions[typeIndex(TypeId::FLOAT)][typeIndex(TypeId::INT)] = Conversion::FLOAT_TO_INT;
+    return conversions;
+}
+
+inline constexpr auto COMPATIBLE_TYPES = buildCompatibility();
+inline constexpr auto ASSIGNABLE_TYPES = buildAssignability();
+inline constexpr auto RESULT_TYPES = buildResultTypes();
+inline constexpr auto CONVERSIONS = buildConversions();
+
+// Queries
+
+constexpr TypeId typeIdOf(TokenType type) { return TOKEN_TYPE_IDS[tokenIndex(type)]; }
+constexpr TypeId typeIdOf(TokenType type, bool isPointer) { return isPointer ? TypeId::POINTER : typeIdOf(type); }
+constexpr OperatorClass operatorClassOf(TokenType op) { return OPERATOR_CLASSES[tokenIndex(op)]; }
+
+constexpr bool isNumericType(TypeId type) { return NUMERIC_TYPES[typeIndex(type)]; }
+constexpr bool isBooleanType(TypeId type) { return type == TypeId::BOOL; }
+constexpr bool isCompatibleType(TypeId left, TypeId right) { return COMPATIBLE_TYPES[typeIndex(left)][typeIndex(right)]; }
+constexpr bool isAssignableType(TypeId target, TypeId value) { return ASSIGNABLE_TYPES[typeIndex(target)][typeIndex(value)]; }
+constexpr TypeId promotedType(TypeId left, TypeId right) { return PROMOTIONS[typeIndex(left)][typeIndex(right)]; }
+constexpr Conversion conversionOf(TypeId from, TypeId to) { return CONVERSIONS[typeIndex(from)][typeIndex(to)]; }
+
+constexpr TypeId resultTypeOf(TokenType op, TypeId left, TypeId right) {
+    return RESULT_TYPES[operatorIndex(operatorClassOf(op))][typeIndex(left)][typeIndex(right)];
+}
+
+constexpr const char* typeName(TypeId type) {
+    constexpr const char* names[TYPE_COUNT] = {
+        "unknown", "void", "bool", "char", "int", "float", "string", "pointer", "function"
+    };
+    return names[typeIndex(type)];
+}
+
+// A value known at compile time, held the way the target holds it: ints are
+// 32-bit two's complement, floats single precision, bools and chars bytes.
+struct Constant {
+    TypeId type = TypeId::ERROR;   // ERROR when the value is not known
+    int32_t integer = 0;           // int, bool and char values
+    float real = 0.0f;             // float values
+    std::string text;              // string values
+
+    bool isConstant() const { return type != TypeId::ERROR; }
+    bool isTrue() const { return type == TypeId::BOOL && integer != 0; }
+    bool equals(const Constant& other) const;
+    std::string toString() const;
+};
+
+// Integer arithmetic wraps around like the target's 32-bit registers
+inline int32_t wrapInteger(int64_t value) {
+    return static_cast<int32_t>(static_cast<uint32_t>(value));
+}
+
+// Constant evaluation with the target's semantics. The result is not
+// constant when the operation has to happen at runtime: division that
+// traps, float results that are not finite, out of range conversions.
+Constant convertConstant(Constant value, TypeId type);
+Constant evaluateBinary(TokenType op, TypeId type, const Constant& left, const Constant& right);
+
+// Reference to a Type interned in a TypeTable. Primitive types are interned
+// first, so the reference of a primitive type equals its TypeId.
+using TypeRef = uint32_t;
+
+constexpr TypeRef primitiveType(TypeId type) { return static_cast<TypeRef>(type); }
+constexpr TypeRef ERROR_TYPE = primitiveType(TypeId::ERROR);
+
+// A structural type: a primitive, a pointer to another type, or a function
+struct Type {
+    TypeId kind;
+    TypeRef element;          // Pointee of a pointer, return type of a function
+    uint32_t firstParameter;  // Function parameter types, stored in the TypeTable
+    uint32_t parameterCount;
+};
+
+// Hash-consed type table. Each distinct type is stored once, so two types are
+// equal exactly when their references are equal.
+class TypeTable {
+private:
+    std::vector<Type> types;
+    std::vector<TypeRef> parameterTypes;
+    std::unordered_map<TypeRef, TypeRef> pointers;          // Pointee to pointer type
+    std::unordered_multimap<size_t, TypeRef> functions;     // Signature hash to function type
+
+    TypeRef add(const Type& type);
+
+public:
+    TypeTable();
+
+    // Interning; the pointer to every primitive type exists from the start
+    TypeRef pointerTo(TypeRef pointee);
+    TypeRef function(TypeRef returnType, const std::vector<TypeRef>& parameters);
+    TypeRef declared(TokenType type, bool isPointer);
+
+    // Lookup without interning, for passes that run concurrently; an
+    // unknown pointer type falls back to the untyped pointer
+    TypeRef findPointerTo(TypeRef pointee) const;
+
+    const Type& get(TypeRef type) const { return types[type]; }
+    TypeId kindOf(TypeRef type) const { return types[type].kind; }
+    TypeRef pointee(TypeRef type) const { return types[type].element; }
+    TypeRef returnType(TypeRef function) const { return types[function].element; }
+    uint32_t parameterCount(TypeRef function) const { return types[function].parameterCount; }
+    TypeRef parameterType(TypeRef function, size_t i) const {
+        return parameterTypes[types[function].firstParameter + i];
+    }
+    size_t size() const { return types.size(); }
+
+    // Type rules on exact types; pointers must also agree on their pointee
+    bool isCompatible(TypeRef left, TypeRef right) const;
+    bool isAssignable(TypeRef target, TypeRef value) const;
+
+    std::string name(TypeRef type) const;
+};
\ No newline at end of file
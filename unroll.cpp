@@ -0,0 +1,406 @@
+// unroll.cpp
+#include "../include/unroll.h"
+#include "../include/reachingdefs.h"
+#include <unordered_map>
+#include <unordered_set>
+
+// A counted loop laid out as one range of instructions
+struct CountedLoop {
+    uint32_t first;          // LABEL of the header
+    uint32_t last;           // One past the latch's JMP, where the exit LABEL is
+    uint32_t exitTest;       // JZ leaving the header
+    uint32_t counter;        // Symbol of the counter
+    OpCode compare;          // The loop goes on while counter compare bound
+    Operand bound;           // A constant, or the variable it is loaded from
+    int32_t step;
+};
+
+// Instructions a header may run any number of times, or not at all
+static bool isHeaderSafe(OpCode op) {
+    switch (op) {
+        case OpCode::LOAD:
+        case OpCode::MOVE:
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MUL:
+        case OpCode::CMPEQ:
+        case OpCode::CMPNE:
+        case OpCode::CMPLT:
+        case OpCode::CMPLE:
+        case OpCode::CMPGT:
+        case OpCode::CMPGE:
+        case OpCode::ITOF:
+        case OpCode::FTOI:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The comparison that holds with its operands swapped
+static OpCode mirrorCompare(OpCode op) {
+    switch (op) {
+        case OpCode::CMPLT: return OpCode::CMPGT;
+        case OpCode::CMPLE: return OpCode::CMPGE;
+        case OpCode::CMPGT: return OpCode::CMPLT;
+        case OpCode::CMPGE: return OpCode::CMPLE;
+        default: return op;
+    }
+}
+
+static bool compareHolds(OpCode op, int64_t left, int64_t right) {
+    switch (op) {
+        case OpCode::CMPLT: return left < right;
+        case OpCode::CMPLE: return left <= right;
+        case OpCode::CMPGT: return left > right;
+        default: return left >= right;
+    }
+}
+
+static bool intConstant(const IRProgram& program, Operand operand, int32_t& value) {
+    if (operand.kind != OperandKind::CONSTANT || program.constants.get(operand.id).type != TypeId::INT) {
+        return false;
+    }
+    value = program.constants.get(operand.id).integer;
+    return true;
+}
+
+static Operand intOperand(IRProgram& program, int32_t value) {
+    Constant constant;
+    constant.type = TypeId::INT;
+    constant.integer = value;
+    return constantOperand(program.constants.intern(constant));
+}
+
+// Matches a natural loop against the counted loop layout
+static bool matchCountedLoop(const IRFunction& function, const IRProgram& program, const ControlFlowGraph& cfg,
+                             const NaturalLoop& loop, const std::unordered_set<uint32_t>& locals, CountedLoop& counted) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    if (loop.latches.size() != 1) {
+        return false;
+    }
+    const BasicBlock& header = cfg.getBlock(loop.header);
+    const BasicBlock& latch = cfg.getBlock(loop.latches[0]);
+    counted.first = header.first;
+    counted.last = latch.last;
+    
+    // The loop fills [first, last) exactly, ends in a jump to the header
+    // and is followed by the label its header exits to
+    uint32_t covered = 0;
+    for (uint32_t block : loop.blocks) {
+        const BasicBlock& bb = cfg.getBlock(block);
+        if (bb.first < counted.first || bb.last > counted.last) {
+            return false;
+        }
+        covered += bb.last - bb.first;
+    }
+    const Instruction& backEdge = instructions[counted.last - 1];
+    if (covered != counted.last - counted.first || header.label == 0 || counted.last >= instructions.size() ||
+        instructions[counted.last].opcode != OpCode::LABEL || backEdge.opcode != OpCode::JMP ||
+        backEdge.getArg1().id != header.label) {
+        return false;
+    }
+    
+    // The header computes a comparison and leaves when it fails
+    counted.exitTest = header.last - 1;
+    const Instruction& exitTest = instructions[counted.exitTest];
+    if (exitTest.opcode != OpCode::JZ || exitTest.getArg2() != instructions[counted.last].getArg1() ||
+        exitTest.getArg1().kind != OperandKind::TEMP) {
+        return false;
+    }
+    std::unordered_map<uint32_t, const Instruction*> headerDefinitions;
+    for (uint32_t i = header.first + 1; i < counted.exitTest; ++i) {
+        if (!isHeaderSafe(instructions[i].opcode)) {
+            return false;
+        }
+        headerDefinitions[instructions[i].getResult().id] = &instructions[i];
+    }
+    auto defined = headerDefinitions.find(exitTest.getArg1().id);
+    if (defined == headerDefinitions.end()) {
+        return false;
+    }
+    const Instruction& test = *defined->second;
+    if (test.type != TypeId::INT || test.opcode < OpCode::CMPLT || test.opcode > OpCode::CMPGE) {
+        return false;
+    }
+    
+    // Variables the loop writes, and whether it calls
+    std::unordered_map<uint32_t, std::vector<uint32_t>> stores;
+    bool hasCall = false;
+    for (uint32_t i = counted.first; i < counted.last; ++i) {
+        if (instructions[i].opcode == OpCode::STORE) {
+            stores[instructions[i].getResult().id].push_back(i);
+        }
+        hasCall = hasCall || instructions[i].opcode == OpCode::CALL;
+    }
+    auto loadedVariable = [&](Operand operand) -> int {
+        auto it = operand.kind == OperandKind::TEMP ? headerDefinitions.find(operand.id) : headerDefinitions.end();
+        if (it == headerDefinitions.end() || it->second->opcode != OpCode::LOAD) {
+            return -1;
+        }
+        return static_cast<int>(it->second->getArg1().id);
+    };
+    
+    for (int side = 0; side < 2; ++side) {
+        Operand counterSide = side == 0 ? test.getArg1() : test.getArg2();
+        Operand boundSide = side == 0 ? test.getArg2() : test.getArg1();
+        int counter = loadedVariable(counterSide);
+        if (counter < 0 || !locals.count(counter) || !stores.count(counter) || stores[counter].size() != 1) {
+            continue;
+        }
+        
+        // The one store to the counter steps it by a constant in the latch
+        uint32_t store = stores[counter][0];
+        if (store < latch.first || instructions[store].type != TypeId::INT ||
+            instructions[store].getArg1().kind != OperandKind::TEMP) {
+            continue;
+        }
+        const Instruction* increment = nullptr;
+        const Instruction* load = nullptr;
+        for (uint32_t i = latch.first; i < store; ++i) {
+            if (instructions[i].getResult() == instructions[store].getArg1()) {
+                increment = &instructions[i];
+            }
+        }
+        int32_t step = 0;
+        Operand stepped;
+        if (increment && increment->opcode == OpCode::ADD) {
+            if (intConstant(program, increment->getArg2(), step)) {
+                stepped = increment->getArg1();
+            } else if (intConstant(program, increment->getArg1(), step)) {
+                stepped = increment->getArg2();
+            }
+        } else if (increment && increment->opcode == OpCode::SUB && intConstant(program, increment->getArg2(), step) &&
+                   step != INT32_MIN) {
+            stepped = increment->getArg1();
+            step = -step;
+        }
+        for (uint32_t i = latch.first; i < store && !stepped.isNone(); ++i) {
+            if (instructions[i].getResult() == stepped) {
+                load = &instructions[i];
+            }
+        }
+        if (step == 0 || !load || load->opcode != OpCode::LOAD || load->getArg1().id != static_cast<uint32_t>(counter)) {
+            continue;
+        }
+        
+        // The bound is a constant or a variable the loop leaves alone
+        int boundVariable = loadedVariable(boundSide);
+        int32_t value;
+        if (boundVariable >= 0) {
+            if (stores.count(boundVariable) || (!locals.count(boundVariable) && hasCall)) {
+                continue;
+            }
+            counted.bound = variableOperand(static_cast<uint32_t>(boundVariable));
+        } else if (intConstant(program, boundSide, value)) {
+            counted.bound = boundSide;
+        } else {
+            continue;
+        }
+        counted.counter = static_cast<uint32_t>(counter);
+        counted.compare = side == 0 ? test.opcode : mirrorCompare(test.opcode);
+        counted.step = step;
+        return true;
+    }
+    return false;
+}
+
+// Value a local or a constant has on entry to the loop, if it is a known
+// constant: the one definition reaching the header from outside stores a
+// constant, in a block that dominates the header
+static bool valueOnEntry(const IRFunction& function, const IRProgram& program, const ControlFlowGraph& cfg,
+                         const ReachingDefinitions& reaching, const NaturalLoop& loop, const CountedLoop& counted,
+                         Operand operand, int32_t& value) {
+    if (operand.kind == OperandKind::CONSTANT) {
+        return intConstant(program, operand, value);
+    }
+    const BitSet& reachingHeader = reaching.getReachingIn(loop.header);
+    int found = -1;
+    for (uint32_t definition : reaching.getDefinitionsOf(operand)) {
+        uint32_t i = reaching.getInstruction(definition);
+        if (!reachingHeader.test(definition) || (i >= counted.first && i < counted.last)) {
+            continue;
+        }
+        if (found >= 0) {
+            return false;
+        }
+        found = static_cast<int>(i);
+    }
+    if (found < 0 || !intConstant(program, function.instructions[found].getArg1(), value)) {
+        return false;
+    }
+    for (uint32_t b = 0; b < cfg.size(); ++b) {
+        const BasicBlock& bb = cfg.getBlock(b);
+        if (static_cast<uint32_t>(found) >= bb.first && static_cast<uint32_t>(found) < bb.last) {
+            return cfg.dominates(b, loop.header);
+        }
+    }
+    return false;
+}
+
+// Appends one iteration of a counted loop, its header without the test
+// and its body without the back edge, with fresh labels and fresh temps
+// for those defined in the loop
+static void appendIteration(IRFunction& function, const CountedLoop& counted, std::vector<Instruction>& out,
+                            std::unordered_set<uint32_t>& copiedLabels) {
+    const std::vector<Instruction>& instructions = function.instructions;
+    std::unordered_map<uint32_t, Operand> temps;
+    std::unordered_map<uint32_t, Operand> labels;
+    for (uint32_t i = counted.first + 1; i < counted.last - 1; ++i) {
+        const Instruction& instr = instructions[i];
+        if (instr.opcode == OpCode::LABEL) {
+            labels[instr.getArg1().id] = function.newLabel();
+            copiedLabels.insert(labels[instr.getArg1().id].id);
+        } else if (instr.getResult().kind == OperandKind::TEMP && !temps.count(instr.getResult().id)) {
+            temps[instr.getResult().id] = function.newTemp();
+        }
+    }
+    
+    for (uint32_t i = counted.first + 1; i < counted.last - 1; ++i) {
+        if (i == counted.exitTest) {
+            continue;
+        }
+        Instruction copy = instructions[i];
+        for (int o = Instruction::RESULT; o <= Instruction::ARG2; ++o) {
+            Operand operand = copy.getOperand(o);
+            if (operand.kind == OperandKind::TEMP && temps.count(operand.id)) {
+                copy.setOperand(o, temps[operand.id]);
+            } else if (operand.kind == OperandKind::LABEL && labels.count(operand.id)) {
+                copy.setOperand(o, labels[operand.id]);
+            }
+        }
+        out.push_back(copy);
+    }
+}
+
+// Replaces the loop with tripCount iterations
+static std::vector<Instruction> unrollFully(IRFunction& function, const CountedLoop& counted, uint32_t tripCount,
+                                            std::unordered_set<uint32_t>& copiedLabels) {
+    std::vector<Instruction> replacement{function.instructions[counted.first]};
+    for (uint32_t copy = 0; copy < tripCount; ++copy) {
+        appendIteration(function, counted, replacement, copiedLabels);
+    }
+    return replacement;
+}
+
+// Puts UNROLL_FACTOR iterations per trip of a new loop in front of the
+// original one, or returns nothing if the moved bound cannot be formed
+static std::vector<Instruction> unrollPartly(IRFunction& function, IRProgram& program, const CountedLoop& counted,
+                                             std::unordered_set<uint32_t>& copiedLabels) {
+    std::vector<Instruction> replacement;
+    Operand epilogue = function.instructions[counted.first].getArg1();
+    int64_t distance = int64_t(UNROLL_FACTOR - 1) * counted.step;
+    if (distance < INT32_MIN || distance > INT32_MAX) {
+        return replacement;
+    }
+    
+    // A constant bound is moved here; a variable one at run time, once a
+    // test has made sure that it will not wrap
+    Operand bound;
+    int32_t value;
+    if (intConstant(program, counted.bound, value)) {
+        int64_t moved = value - distance;
+        if (moved < INT32_MIN || moved > INT32_MAX) {
+            return replacement;
+        }
+        bound = intOperand(program, static_cast<int32_t>(moved));
+    } else {
+        Operand loaded = function.newTemp();
+        Operand fits = function.newTemp();
+        int64_t limit = counted.step > 0 ? INT32_MIN + distance : INT32_MAX + distance;
+        replacement.emplace_back(OpCode::LOAD, TypeId::INT, loaded, counted.bound);
+        replacement.emplace_back(counted.step > 0 ? OpCode::CMPGE : OpCode::CMPLE, TypeId::INT, fits, loaded,
+                                 intOperand(program, static_cast<int32_t>(limit)));
+        replacement.emplace_back(OpCode::JZ, TypeId::BOOL, Operand(), fits, epilogue);
+    }
+    
+    Operand start = function.newLabel();
+    copiedLabels.insert(start.id);
+    replacement.emplace_back(OpCode::LABEL, TypeId::VOID, Operand(), start);
+    Operand counter = function.newTemp();
+    replacement.emplace_back(OpCode::LOAD, TypeId::INT, counter, variableOperand(counted.counter));
+    if (bound.isNone()) {
+        Operand loaded = function.newTemp();
+        bound = function.newTemp();
+        replacement.emplace_back(OpCode::LOAD, TypeId::INT, loaded, counted.bound);
+        replacement.emplace_back(OpCode::SUB, TypeId::INT, bound, loaded, intOperand(program, static_cast<int32_t>(distance)));
+    }
+    Operand remaining = function.newTemp();
+    replacement.emplace_back(counted.compare, TypeId::INT, remaining, counter, bound);
+    replacement.emplace_back(OpCode::JZ, TypeId::BOOL, Operand(), remaining, epilogue);
+    for (uint32_t copy = 0; copy < UNROLL_FACTOR; ++copy) {
+        appendIteration(function, counted, replacement, copiedLabels);
+    }
+    replacement.emplace_back(OpCode::JMP, TypeId::VOID, Operand(), start);
+    
+    replacement.insert(replacement.end(), function.instructions.begin() + counted.first,
+                       function.instructions.begin() + counted.last);
+    return replacement;
+}
+
+void LoopUnrollPass::runOnFunction(IRFunction& function, IRProgram& program) {
+    if (function.ssa) {
+        return;
+    }
+    std::unordered_set<uint32_t> locals;
+    for (const auto* variables : {&function.parameters, &function.locals}) {
+        for (const IRVariable& variable : *variables) {
+            locals.insert(variable.symbol);
+        }
+    }
+    
+    // Each loop is visited once, by its header, and copies of loops are not
+    // visited at all; the graph is rebuilt after every change
+    size_t budget = std::max<size_t>(function.instructions.size(), UNROLL_LOOP_BUDGET);
+    size_t limit = function.instructions.size() + budget;
+    std::unordered_set<uint32_t> visited;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        ControlFlowGraph cfg(function);
+        for (const NaturalLoop& loop : cfg.findNaturalLoops()) {
+            if (!visited.insert(cfg.getBlock(loop.header).label).second) {
+                continue;
+            }
+            CountedLoop counted;
+            if (!matchCountedLoop(function, program, cfg, loop, locals, counted)) {
+                continue;
+            }
+            
+            // Simulate the counter when its start and the bound are known
+            uint32_t size = counted.last - counted.first;
+            ReachingDefinitions reaching(function, cfg);
+            int32_t start;
+            int32_t bound;
+            uint32_t tripCount = FULL_UNROLL_MAX_TRIPS + 1;
+            if (valueOnEntry(function, program, cfg, reaching, loop, counted, variableOperand(counted.counter), start) &&
+                valueOnEntry(function, program, cfg, reaching, loop, counted, counted.bound, bound)) {
+                int64_t counter = start;
+                for (tripCount = 0; tripCount <= FULL_UNROLL_MAX_TRIPS; ++tripCount) {
+                    if (!compareHolds(counted.compare, counter, bound)) {
+                        break;
+                    }
+                    counter = wrapInteger(counter + counted.step);
+                }
+            }
+            
+            std::vector<Instruction> replacement;
+            if (tripCount <= FULL_UNROLL_MAX_TRIPS && tripCount * size <= UNROLL_LOOP_BUDGET) {
+                replacement = unrollFully(function, counted, tripCount, visited);
+            } else if ((UNROLL_FACTOR + 1) * size <= UNROLL_LOOP_BUDGET &&
+                       (counted.step > 0) == (counted.compare == OpCode::CMPLT || counted.compare == OpCode::CMPLE)) {
+                replacement = unrollPartly(function, program, counted, visited);
+            }
+            size_t grown = function.instructions.size() - size + replacement.size();
+            if (replacement.empty() || grown > limit) {
+                continue;
+            }
+            
+            std::vector<Instruction>& instructions = function.instructions;
+            instructions.erase(instructions.begin() + counted.first, instructions.begin() + counted.last);
+            instructions.insert(instructions.begin() + counted.first, replacement.begin(), replacement.end());
+            changed = true;
+            break;
+        }
+    }
+}
\ No newline at end of file
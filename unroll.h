@@ -0,0 +1,34 @@
+// unroll.h
+#pragma once
+#include "optimizer.h"
+
+// Limits on how far loops are unrolled
+constexpr uint32_t FULL_UNROLL_MAX_TRIPS = 16;   // Most iterations of a loop unrolled fully
+constexpr uint32_t UNROLL_FACTOR = 4;            // Copies of the body in a partly unrolled loop
+constexpr uint32_t UNROLL_LOOP_BUDGET = 256;     // Most instructions one unrolled loop may grow to
+
+// Unrolling of counted loops before SSA construction. A counted loop has
+// the layout the code generator gives while and for statements: a header
+// that tests a local counter against a bound and exits to the label right
+// after the loop, a body, and one latch that steps the counter by a
+// constant and jumps back. The header may not have side effects or trap.
+//
+// When the counter's start and the bound are constants on entry, the trip
+// count is known, and a loop of at most FULL_UNROLL_MAX_TRIPS iterations is
+// replaced by that many copies of its body. Otherwise a counter stepping
+// toward its bound is unrolled UNROLL_FACTOR times: the unrolled loop runs
+// while a whole group of iterations is left, tested once per group against
+// the bound moved back by the steps in between, and the original loop
+// follows as the epilogue for the rest. When the bound is a variable, a
+// test before the unrolled loop sends bounds too close to the end of the
+// integer range, where the moved bound would wrap, straight to the
+// epilogue.
+//
+// Growth is kept within UNROLL_LOOP_BUDGET instructions per loop, and the
+// whole function grows by no more than its size or the budget, whichever
+// is larger. Inner loops are unrolled first.
+class LoopUnrollPass : public FunctionPass {
+public:
+    const char* getName() const override { return "unroll"; }
+    void runOnFunction(IRFunction& function, IRProgram& program) override;
+};
\ No newline at end of file